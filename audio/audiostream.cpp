@@ -19,10 +19,13 @@
  *
  */
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/mutex.h"
+#include "common/system.h"
 #include "common/textconsole.h"
+#include "common/timer.h"
 #include "common/queue.h"
 #include "common/util.h"
 
@@ -468,6 +471,331 @@ AudioStream *makeLimitingAudioStream(AudioStream *parentStream, const Timestamp
 	return new LimitingAudioStream(parentStream, length, disposeAfterUse);
 }
 
+/**
+ * A ring buffer that reads an AudioStream ahead of playback, from the
+ * timer thread.
+ *
+ * All instances share one timer proc, since the timer manager does not
+ * allow installing the same one twice. It removes itself once there is
+ * nothing left to render.
+ *
+ * The timer thread is shared with every other timer proc, and the timer
+ * manager holds its mutex while rendering. Hence each call renders at most
+ * kMaxRenderMillis of every buffer, enough to catch up after a late call
+ * without delaying the other procs for long.
+ *
+ * Lock order is _buffersMutex, then _renderMutex, then _mutex. The
+ * registry lock is never held while rendering, so destroying one buffer
+ * only ever waits for that buffer to finish rendering.
+ */
+class RenderAheadBuffer {
+public:
+	enum {
+		kTimerInterval = 10000, ///< Interval of the timer proc, in microseconds
+		kMaxRenderMillis = 20   ///< Audio rendered per buffer and timer call at most, in milliseconds
+	};
+
+	/**
+	 * @param stream   The stream to render. It must outlive this buffer.
+	 * @param prefill  Whether to fill the buffer once from the calling
+	 *                 thread, instead of starting with an underrun.
+	 */
+	RenderAheadBuffer(AudioStream *stream, uint32 aheadMillis, bool prefill);
+	~RenderAheadBuffer();
+
+	int read(int16 *buffer, const int numSamples);
+	bool endOfData() const;
+	bool endOfStream() const;
+	uint32 getUnderruns() const;
+
+	/**
+	 * Seek the rendered stream, which must be a SeekableAudioStream, and
+	 * refill the buffer from the new position, from the calling thread.
+	 * This waits for the timer thread to finish rendering this buffer.
+	 *
+	 * @return False if the stream could not seek, which ends it.
+	 */
+	bool seek(const Timestamp &where);
+
+private:
+	/**
+	 * Read the stream until the buffer is full, or @p maxSamples samples
+	 * have been read. 0 means no limit.
+	 */
+	void render(uint32 maxSamples);
+
+	static void timerProc(void *refCon);
+
+	static Common::Array<RenderAheadBuffer *> *_buffers;
+	static Common::Mutex *_buffersMutex;
+	static bool _timerInstalled;
+
+	AudioStream *_stream;
+
+	int16 *_buffer;
+	uint32 _bufferSize;
+	uint32 _maxRenderSamples;
+
+	// Held while reading from _stream, outside of the constructor.
+	Common::Mutex _renderMutex;
+
+	// Guarded by _renderMutex
+	uint32 _writePos;
+
+	// Guarded by _mutex. _generation changes whenever seeking drops the
+	// buffer contents, so that a concurrent read does not publish stale
+	// positions.
+	mutable Common::Mutex _mutex;
+	uint32 _readPos;
+	uint32 _available;
+	uint32 _generation;
+	uint32 _underruns;
+	bool _streamEndOfData;
+	bool _streamEndOfStream;
+};
+
+Common::Array<RenderAheadBuffer *> *RenderAheadBuffer::_buffers = nullptr;
+Common::Mutex *RenderAheadBuffer::_buffersMutex = nullptr;
+bool RenderAheadBuffer::_timerInstalled = false;
+
+RenderAheadBuffer::RenderAheadBuffer(AudioStream *stream, uint32 aheadMillis, bool prefill) :
+		_stream(stream), _writePos(0), _readPos(0), _available(0), _generation(0), _underruns(0),
+		_streamEndOfData(false), _streamEndOfStream(false) {
+	const uint32 channels = stream->isStereo() ? 2 : 1;
+	_bufferSize = MAX<uint32>((uint64)stream->getRate() * aheadMillis / 1000, 1) * channels;
+	_buffer = new int16[_bufferSize];
+	_maxRenderSamples = MAX<uint32>((uint64)stream->getRate() * kMaxRenderMillis / 1000, 1) * channels;
+
+	// Not visible to the timer proc yet, so no locking is needed.
+	if (prefill)
+		render(0);
+
+	// Streams are only created from the main thread, so this cannot race.
+	if (!_buffersMutex) {
+		_buffersMutex = new Common::Mutex();
+		_buffers = new Common::Array<RenderAheadBuffer *>();
+	}
+
+	// Never call into the timer manager while holding _buffersMutex: it
+	// holds its own mutex while calling timerProc().
+	_buffersMutex->lock();
+	_buffers->push_back(this);
+	bool installTimer = !_timerInstalled;
+	_timerInstalled = true;
+	_buffersMutex->unlock();
+
+	if (installTimer)
+		g_system->getTimerManager()->installTimerProc(&timerProc, kTimerInterval, nullptr, "RenderAheadBuffer");
+}
+
+RenderAheadBuffer::~RenderAheadBuffer() {
+	_buffersMutex->lock();
+	for (uint i = 0; i < _buffers->size(); ++i) {
+		if ((*_buffers)[i] == this) {
+			_buffers->remove_at(i);
+			break;
+		}
+	}
+	_buffersMutex->unlock();
+
+	// The timer proc may still be rendering this buffer, but it cannot pick
+	// it up again now. Other buffers being rendered are not waited for.
+	_renderMutex.lock();
+	_renderMutex.unlock();
+
+	if (_underruns)
+		debug(3, "RenderAheadBuffer: Rendering fell behind playback %u times", _underruns);
+
+	delete[] _buffer;
+}
+
+int RenderAheadBuffer::read(int16 *buffer, const int numSamples) {
+	_mutex.lock();
+	const uint32 readPos = _readPos;
+	const uint32 available = _available;
+	const uint32 generation = _generation;
+	const bool streamEnded = _streamEndOfData;
+	_mutex.unlock();
+
+	uint32 samples = MIN<uint32>(numSamples, available);
+	uint32 count = MIN<uint32>(samples, _bufferSize - readPos);
+	memcpy(buffer, _buffer + readPos, count * sizeof(int16));
+	memcpy(buffer + count, _buffer, (samples - count) * sizeof(int16));
+
+	const bool underrun = samples < (uint32)numSamples && !streamEnded;
+
+	_mutex.lock();
+	if (_generation == generation) {
+		_readPos = (readPos + samples) % _bufferSize;
+		_available -= samples;
+		if (underrun)
+			++_underruns;
+	}
+	_mutex.unlock();
+
+	if (!underrun)
+		return samples;
+
+	// Rendering fell behind, play silence rather than waiting for it.
+	memset(buffer + samples, 0, (numSamples - samples) * sizeof(int16));
+	return numSamples;
+}
+
+bool RenderAheadBuffer::endOfData() const {
+	Common::StackLock lock(_mutex);
+	return _available == 0 && _streamEndOfData;
+}
+
+bool RenderAheadBuffer::endOfStream() const {
+	Common::StackLock lock(_mutex);
+	return _available == 0 && _streamEndOfStream;
+}
+
+uint32 RenderAheadBuffer::getUnderruns() const {
+	Common::StackLock lock(_mutex);
+	return _underruns;
+}
+
+bool RenderAheadBuffer::seek(const Timestamp &where) {
+	SeekableAudioStream *stream = dynamic_cast<SeekableAudioStream *>(_stream);
+	assert(stream);
+
+	// Seeking right away and refilling the buffer, rather than leaving it to
+	// the timer thread, keeps looping through LoopingAudioStream gapless.
+	Common::StackLock renderLock(_renderMutex);
+
+	const bool seeked = stream->seek(where);
+	_writePos = 0;
+
+	_mutex.lock();
+	_readPos = 0;
+	_available = 0;
+	++_generation;
+	// Treat a failed seek like the end of the stream.
+	_streamEndOfData = _streamEndOfStream = !seeked;
+	_mutex.unlock();
+
+	if (seeked)
+		render(0);
+	return seeked;
+}
+
+void RenderAheadBuffer::render(uint32 maxSamples) {
+	// seek() holds _renderMutex as well, so only reads happen meanwhile,
+	// which only ever make more space.
+	_mutex.lock();
+	uint32 space = _bufferSize - _available;
+	_mutex.unlock();
+
+	if (maxSamples && space > maxSamples)
+		space = maxSamples;
+
+	while (space) {
+		// Both are multiples of the channel count, so are all chunks.
+		const uint32 count = MIN<uint32>(space, _bufferSize - _writePos);
+		const int rendered = _stream->readBuffer(_buffer + _writePos, count);
+		const bool endOfData = _stream->endOfData();
+		const bool endOfStream = _stream->endOfStream();
+
+		_writePos = (_writePos + rendered) % _bufferSize;
+		space -= rendered;
+
+		_mutex.lock();
+		_available += rendered;
+		_streamEndOfData = endOfData;
+		_streamEndOfStream = endOfStream;
+		_mutex.unlock();
+
+		if ((uint32)rendered < count)
+			break;
+	}
+}
+
+void RenderAheadBuffer::timerProc(void *refCon) {
+	// Buffers removed meanwhile may make this skip one buffer, which is
+	// then rendered on the next call.
+	for (uint i = 0; ; ++i) {
+		_buffersMutex->lock();
+		if (i >= _buffers->size())
+			break;
+
+		// Locked before releasing _buffersMutex, so the buffer cannot be
+		// destroyed before rendering is done.
+		RenderAheadBuffer *buffer = (*_buffers)[i];
+		buffer->_renderMutex.lock();
+		_buffersMutex->unlock();
+
+		buffer->render(buffer->_maxRenderSamples);
+		buffer->_renderMutex.unlock();
+	}
+
+	// Still holding _buffersMutex from the last iteration.
+	if (_buffers->empty()) {
+		g_system->getTimerManager()->removeTimerProc(&timerProc);
+		_timerInstalled = false;
+	}
+	_buffersMutex->unlock();
+}
+
+/**
+ * An AudioStream wrapper that reads its parent stream ahead of playback.
+ */
+class RenderAheadAudioStream : public AudioStream {
+public:
+	RenderAheadAudioStream(AudioStream *parentStream, uint32 aheadMillis, DisposeAfterUse::Flag disposeAfterUse) :
+		_parentStream(parentStream, disposeAfterUse), _isStereo(parentStream->isStereo()), _rate(parentStream->getRate()),
+		_buffer(parentStream, aheadMillis, false) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override { return _buffer.read(buffer, numSamples); }
+
+	bool endOfData() const override { return _buffer.endOfData(); }
+	bool endOfStream() const override { return _buffer.endOfStream(); }
+	bool isStereo() const override { return _isStereo; }
+	int getRate() const override { return _rate; }
+
+private:
+	// Declared before _buffer, so it is destroyed after it.
+	Common::DisposablePtr<AudioStream> _parentStream;
+	const bool _isStereo;
+	const int _rate;
+	RenderAheadBuffer _buffer;
+};
+
+AudioStream *makeRenderAheadStream(AudioStream *parentStream, uint32 aheadMillis, DisposeAfterUse::Flag disposeAfterUse) {
+	return new RenderAheadAudioStream(parentStream, aheadMillis, disposeAfterUse);
+}
+
+class PrefetchingAudioStreamImpl : public PrefetchingAudioStream {
+public:
+	PrefetchingAudioStreamImpl(SeekableAudioStream *parentStream, uint32 aheadMillis, DisposeAfterUse::Flag disposeAfterUse) :
+		_parentStream(parentStream, disposeAfterUse), _isStereo(parentStream->isStereo()), _rate(parentStream->getRate()),
+		_length(parentStream->getLength()), _buffer(parentStream, aheadMillis, true) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override { return _buffer.read(buffer, numSamples); }
+
+	bool endOfData() const override { return _buffer.endOfData(); }
+	bool endOfStream() const override { return _buffer.endOfStream(); }
+	bool isStereo() const override { return _isStereo; }
+	int getRate() const override { return _rate; }
+
+	bool seek(const Timestamp &where) override { return _buffer.seek(where); }
+	Timestamp getLength() const override { return _length; }
+
+	uint32 getUnderruns() const override { return _buffer.getUnderruns(); }
+
+private:
+	// Declared before _buffer, so it is destroyed after it.
+	Common::DisposablePtr<SeekableAudioStream> _parentStream;
+	const bool _isStereo;
+	const int _rate;
+	const Timestamp _length;
+	RenderAheadBuffer _buffer;
+};
+
+PrefetchingAudioStream *makePrefetchingAudioStream(SeekableAudioStream *parentStream, uint32 aheadMillis, DisposeAfterUse::Flag disposeAfterUse) {
+	return new PrefetchingAudioStreamImpl(parentStream, aheadMillis, disposeAfterUse);
+}
+
 /**
  * An AudioStream that plays nothing and immediately returns that
  * the endOfStream() has been reached
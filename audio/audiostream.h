@@ -436,6 +436,67 @@ Timestamp convertTimeToStreamPos(const Timestamp &where, int rate, bool isStereo
  */
 AudioStream *makeLimitingAudioStream(AudioStream *parentStream, const Timestamp &length, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
 
+/**
+ * Factory function for an AudioStream wrapper that reads its parent stream
+ * ahead of playback from the timer thread.
+ *
+ * This moves expensive rendering, like that of emulated synthesizers, out of
+ * the mixer callback, which then only copies samples out of a ring buffer.
+ * Anything done by the parent stream while rendering, like calling the timer
+ * callbacks of a MIDI driver, stays exact to the sample. However, changes
+ * made to the parent stream from other threads are only heard after up to
+ * @p aheadMillis milliseconds. If rendering falls behind, silence is
+ * played instead.
+ *
+ * Only the returned stream may read from the parent stream, and it does so
+ * from the timer thread. That thread is shared with all other timer procs,
+ * like those of MIDI drivers, and the timer manager holds its mutex while
+ * calling them. Rendering therefore delays them. To bound that delay, each
+ * timer call renders at most 20ms of audio per stream, so rendering catches
+ * up after falling behind at twice the playback speed at most.
+ *
+ * @param parentStream     The stream to render ahead.
+ * @param aheadMillis      How far to render ahead, in milliseconds. The
+ *                         timer thread runs only every 10ms or so, hence
+ *                         this should be a multiple of that.
+ * @param disposeAfterUse  Whether the parent stream object should be destroyed on destruction of the returned stream.
+ */
+AudioStream *makeRenderAheadStream(AudioStream *parentStream, uint32 aheadMillis, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
+/**
+ * A SeekableAudioStream wrapper that decodes its parent stream ahead of
+ * playback from the timer thread, like makeRenderAheadStream.
+ *
+ * This keeps decoding spikes of compressed streams out of the mixer
+ * callback. If decoding falls behind anyway, silence is played instead,
+ * and the underrun is counted.
+ *
+ * Seeking and rewinding seek the parent stream right away, and decode
+ * ahead from the new position from the calling thread, like creating the
+ * stream does. This keeps looping it with LoopingAudioStream gapless. If
+ * the parent stream fails to seek, the stream ends.
+ */
+class PrefetchingAudioStream : public SeekableAudioStream {
+public:
+	/**
+	 * Return how often decoding fell behind playback.
+	 */
+	virtual uint32 getUnderruns() const = 0;
+};
+
+/**
+ * Factory function for a PrefetchingAudioStream.
+ *
+ * The parent stream is decoded ahead once on creation, so playback does
+ * not start with an underrun. Only the returned stream may access the
+ * parent stream afterwards.
+ *
+ * @param parentStream     The stream to decode ahead.
+ * @param aheadMillis      How far to decode ahead, in milliseconds.
+ * @param disposeAfterUse  Whether the parent stream object should be destroyed on destruction of the returned stream.
+ */
+PrefetchingAudioStream *makePrefetchingAudioStream(SeekableAudioStream *parentStream, uint32 aheadMillis = 300, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
 /**
  * An AudioStream designed to work in terms of packets.
  *
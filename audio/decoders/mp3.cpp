@@ -23,6 +23,7 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/mutex.h"
 #include "common/ptr.h"
@@ -108,6 +109,26 @@ protected:
 
 private:
 	static Common::SeekableReadStream *skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose);
+
+	/**
+	 * A frame where decoding can be restarted when seeking.
+	 */
+	struct SeekPoint {
+		uint32 offset;    ///< Position of the frame in _inStream
+		mad_timer_t time; ///< Playback time at the start of the frame
+	};
+
+	const SeekPoint &findSeekPoint(const mad_timer_t &time) const;
+
+	/**
+	 * One seek point for about every kSeekPointInterval seconds of the
+	 * stream, in order. Collected while calculating the length.
+	 */
+	Common::Array<SeekPoint> _seekPoints;
+
+	enum {
+		kSeekPointInterval = 1
+	};
 };
 
 class PacketizedMP3Stream : private BaseMP3Stream, public PacketizedAudioStream {
@@ -336,10 +357,32 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_channels = MAD_NCHANNELS(&_frame.header);
 	_rate = _frame.header.samplerate;
 
-	// Calculate the length of the stream
-	while (_state != MP3_STATE_EOS)
+	// Calculate the length of the stream. Since this walks over all frame
+	// headers anyway, also remember where frames start every so often, so
+	// that seeking does not need to do the same.
+	SeekPoint seekPoint;
+	seekPoint.offset = 0;
+	seekPoint.time = mad_timer_zero;
+	_seekPoints.push_back(seekPoint);
+
+	mad_timer_t seekPointInterval;
+	mad_timer_set(&seekPointInterval, kSeekPointInterval, 0, 1);
+	mad_timer_t nextSeekPoint = seekPointInterval;
+
+	while (_state != MP3_STATE_EOS) {
+		const mad_timer_t frameTime = _curTime;
 		readHeader(*_inStream);
 
+		if (_state != MP3_STATE_EOS && mad_timer_compare(frameTime, nextSeekPoint) >= 0) {
+			seekPoint.offset = _inStream->pos() - (_stream.bufend - _stream.this_frame);
+			seekPoint.time = frameTime;
+			_seekPoints.push_back(seekPoint);
+
+			while (mad_timer_compare(frameTime, nextSeekPoint) >= 0)
+				mad_timer_add(&nextSeekPoint, seekPointInterval);
+		}
+	}
+
 	// To rule out any invalid sample rate to be encountered here, say in case the
 	// MP3 stream is invalid, we just check the MAD error code here.
 	// We need to assure this, since else we might trigger an assertion in Timestamp
@@ -376,9 +419,13 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
-		_inStream->seek(0);
+	// Restart decoding at the closest known frame, unless we are already
+	// past it and only need to skip forward.
+	const SeekPoint &seekPoint = findSeekPoint(destination);
+	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0 || mad_timer_compare(seekPoint.time, _curTime) > 0) {
+		_inStream->seek(seekPoint.offset);
 		initStream(*_inStream);
+		_curTime = seekPoint.time;
 	}
 
 	while (mad_timer_compare(destination, _curTime) > 0 && _state != MP3_STATE_EOS)
@@ -389,6 +436,21 @@ bool MP3Stream::seek(const Timestamp &where) {
 	return (_state != MP3_STATE_EOS);
 }
 
+const MP3Stream::SeekPoint &MP3Stream::findSeekPoint(const mad_timer_t &time) const {
+	// Binary search for the last seek point not after the given time. The
+	// first one is at the start of the stream, so there always is one.
+	uint first = 0, last = _seekPoints.size() - 1;
+	while (first < last) {
+		const uint mid = (first + last + 1) / 2;
+		if (mad_timer_compare(_seekPoints[mid].time, time) <= 0)
+			first = mid;
+		else
+			last = mid - 1;
+	}
+
+	return _seekPoints[first];
+}
+
 Common::SeekableReadStream *MP3Stream::skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose) {
 	// Skip ID3 TAG if any
 	// ID3v1 (beginning with with 'TAG') is located at the end of files. So we can ignore those.
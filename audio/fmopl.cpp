@@ -406,7 +406,8 @@ EmulatedOPL::EmulatedOPL() :
 	_nextTick(0),
 	_samplesPerTick(0),
 	_baseFreq(0),
-	_handle(new Audio::SoundHandle()) {
+	_handle(new Audio::SoundHandle()),
+	_renderAheadStream(nullptr) {
 }
 
 EmulatedOPL::~EmulatedOPL() {
@@ -452,11 +453,21 @@ int EmulatedOPL::getRate() const {
 
 void EmulatedOPL::startCallbacks(int timerFrequency) {
 	setCallbackFrequency(timerFrequency);
-	g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+
+	// Cores like Nuked OPL3 may be too slow to render in the mixer callback.
+	Audio::AudioStream *stream = this;
+	int renderAhead = ConfMan.getInt("synth_render_ahead");
+	if (renderAhead > 0)
+		stream = _renderAheadStream = Audio::makeRenderAheadStream(this, renderAhead, DisposeAfterUse::NO);
+
+	g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, stream, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 }
 
 void EmulatedOPL::stopCallbacks() {
 	g_system->getMixer()->stopHandle(*_handle);
+
+	delete _renderAheadStream;
+	_renderAheadStream = nullptr;
 }
 
 void EmulatedOPL::setCallbackFrequency(int timerFrequency) {
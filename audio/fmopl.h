@@ -310,6 +310,7 @@ private:
 	int _samplesPerTick;
 
 	Audio::SoundHandle *_handle;
+	Audio::AudioStream *_renderAheadStream;
 };
 /** @} */
 } // End of namespace OPL
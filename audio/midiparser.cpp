@@ -21,6 +21,7 @@
 
 #include "audio/midiparser.h"
 #include "audio/mididrv.h"
+#include "common/ptr.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
@@ -384,6 +385,7 @@ bool MidiParser::setTrack(int track) {
 		allNotesOff();
 
 	resetTracking();
+	_jumpSnapshots.clear();
 	_pause = false;
 	memset(_activeNotes, 0, sizeof(_activeNotes));
 	if (_disableAutoStartPlayback)
@@ -462,6 +464,155 @@ void MidiParser::hangAllActiveNotes() {
 	}
 }
 
+/**
+ * Keeps the events a jump which fires events has to replay, to restore
+ * the channel, SysEx and META state at the current point of a scan.
+ * See JumpSnapshot::replayEvents.
+ */
+class JumpReplayState {
+public:
+	JumpReplayState() : _numDead(0) {
+		_latest.resize(kNumKeys);
+	}
+
+	void addEvent(const EventInfo &info) {
+		const uint channel = info.channel();
+		switch (info.command()) {
+		case 0x8:
+			remove(kNoteKeys + channel * 128 + info.basic.param1);
+			return;
+		case 0x9:
+			if (info.basic.param2 == 0) {
+				remove(kNoteKeys + channel * 128 + info.basic.param1);
+				return;
+			}
+			break;
+		case 0xB:
+			// Channel mode messages 120 and 123 to 127 end all notes
+			if (info.basic.param1 == 120 || info.basic.param1 >= 123) {
+				for (uint note = 0; note < 128; ++note)
+					remove(kNoteKeys + channel * 128 + note);
+			}
+			break;
+		default:
+			break;
+		}
+
+		const int key = getKey(info);
+		if (key >= 0)
+			remove(key);
+
+		Entry entry;
+		entry.info = info;
+		entry.key = key;
+		entry.alive = true;
+		_events.push_back(entry);
+		if (key >= 0)
+			_latest[key] = _events.size();
+	}
+
+	void addEvents(const Common::Array<EventInfo> &events) {
+		for (uint i = 0; i < events.size(); ++i)
+			addEvent(events[i]);
+	}
+
+	void getEvents(Common::Array<EventInfo> &events) const {
+		events.reserve(_events.size() - _numDead);
+		for (uint i = 0; i < _events.size(); ++i) {
+			if (_events[i].alive)
+				events.push_back(_events[i].info);
+		}
+	}
+
+private:
+	enum {
+		kNoteKeys = 0,
+		kPolyPressureKeys = kNoteKeys + 16 * 128,
+		kControllerKeys = kPolyPressureKeys + 16 * 128,
+		kProgramKeys = kControllerKeys + 16 * 128,
+		kChannelPressureKeys = kProgramKeys + 16,
+		kPitchBendKeys = kChannelPressureKeys + 16,
+		kTempoKey = kPitchBendKeys + 16,
+		kNumKeys
+	};
+
+	struct Entry {
+		EventInfo info;
+		int key;
+		bool alive;
+	};
+
+	/**
+	 * Return the state set by the event, or -1 if the event is kept
+	 * regardless of the events following it.
+	 */
+	static int getKey(const EventInfo &info) {
+		const uint channel = info.channel();
+		switch (info.command()) {
+		case 0x9:
+			return kNoteKeys + channel * 128 + info.basic.param1;
+		case 0xA:
+			return kPolyPressureKeys + channel * 128 + info.basic.param1;
+		case 0xB:
+			switch (info.basic.param1) {
+			case 0:   // Bank select, which applies to the next program change
+			case 6:   // Data entry, which applies to the current (N)RPN
+			case 32:
+			case 38:
+			case 96:  // Data increment and decrement
+			case 97:
+			case 98:  // (N)RPN selection
+			case 99:
+			case 100:
+			case 101:
+				return -1;
+			default:
+				// Channel mode messages are not state either
+				return info.basic.param1 >= 120 ? -1 : kControllerKeys + channel * 128 + info.basic.param1;
+			}
+		case 0xC:
+			return kProgramKeys + channel;
+		case 0xD:
+			return kChannelPressureKeys + channel;
+		case 0xE:
+			return kPitchBendKeys + channel;
+		default:
+			return (info.event == 0xFF && info.ext.type == 0x51) ? kTempoKey : -1;
+		}
+	}
+
+	void remove(uint key) {
+		if (!_latest[key])
+			return;
+
+		_events[_latest[key] - 1].alive = false;
+		_latest[key] = 0;
+		++_numDead;
+
+		if (_numDead > 256 && _numDead > _events.size() / 2)
+			compact();
+	}
+
+	void compact() {
+		uint count = 0;
+		for (uint i = 0; i < _events.size(); ++i) {
+			if (!_events[i].alive)
+				continue;
+
+			_events[count] = _events[i];
+			++count;
+			if (_events[i].key >= 0)
+				_latest[_events[i].key] = count;
+		}
+		_events.resize(count);
+		_numDead = 0;
+	}
+
+	Common::Array<Entry> _events;
+	Common::Array<uint32> _latest; ///< Index + 1 in _events of the last event setting each state, 0 if none.
+	uint _numDead;
+};
+
 bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool dontSendNoteOn) {
 	if (_activeTrack >= _numTracks || _pause)
 		return false;
@@ -472,9 +623,49 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	Tracker currentPos(_position);
 	EventInfo currentEvent(_nextEvent);
 
+	// The scan starts with the current tempo, so the times up to the
+	// first tempo event depend on it. Snapshots store these ticks
+	// separately, and their times are adjusted when restoring them.
+	const uint32 scanPsecPerTick = _psecPerTick;
+	uint32 eventIndex = 0;
+	uint32 initialTicks = 0;
+	bool tempoSet = false;
+
 	resetTracking();
-	_position._playPos = _tracks[_activeTrack];
-	parseNextEvent(_nextEvent);
+	const JumpSnapshot *snapshot = nullptr;
+	Common::ScopedPtr<JumpReplayState> replayState;
+	if (supportsJumpSnapshots()) {
+		snapshot = findJumpSnapshot(tick);
+		replayState.reset(new JumpReplayState());
+	}
+
+	if (snapshot) {
+		_position = snapshot->position;
+		_position._lastEventTime += snapshot->initialTicks * scanPsecPerTick;
+		_position._playTime = _position._lastEventTime;
+		_nextEvent = snapshot->nextEvent;
+		eventIndex = snapshot->eventIndex;
+		initialTicks = snapshot->initialTicks;
+		tempoSet = snapshot->tempoSet;
+		if (tempoSet) {
+			_tempo = snapshot->tempo;
+			_psecPerTick = snapshot->psecPerTick;
+		}
+
+		// Send the state a scan from the start would have sent
+		replayState->addEvents(snapshot->replayEvents);
+		if (fireEvents) {
+			for (uint i = 0; i < snapshot->replayEvents.size(); ++i) {
+				const EventInfo &info = snapshot->replayEvents[i];
+				if (info.command() != 0x9 || !dontSendNoteOn)
+					processEvent(info, true);
+			}
+		}
+	} else {
+		_position._playPos = _tracks[_activeTrack];
+		parseNextEvent(_nextEvent);
+	}
+
 	if (tick > 0) {
 		while (true) {
 			EventInfo &info = _nextEvent;
@@ -489,6 +680,12 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 			_position._playTick = _position._lastEventTick;
 			_position._playTime = _position._lastEventTime;
 
+			if (!tempoSet) {
+				initialTicks = _position._lastEventTick;
+				if (info.event == 0xFF && info.ext.type == 0x51)
+					tempoSet = true;
+			}
+
 			// Some special processing for the fast-forward case
 			if (info.command() == 0x9 && dontSendNoteOn) {
 				// Don't send note on; doing so creates a "warble" with
@@ -504,7 +701,27 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 				processEvent(info, fireEvents);
 			}
 
+			if (replayState)
+				replayState->addEvent(info);
+
 			parseNextEvent(_nextEvent);
+
+			++eventIndex;
+			if (eventIndex % JUMP_SNAPSHOT_INTERVAL == 0 && supportsJumpSnapshots() &&
+					(_jumpSnapshots.empty() || _jumpSnapshots.back().eventIndex < eventIndex)) {
+				JumpSnapshot newSnapshot;
+				newSnapshot.position = _position;
+				newSnapshot.position._lastEventTime -= initialTicks * scanPsecPerTick;
+				newSnapshot.position._playTime = newSnapshot.position._lastEventTime;
+				newSnapshot.nextEvent = _nextEvent;
+				newSnapshot.eventIndex = eventIndex;
+				newSnapshot.initialTicks = initialTicks;
+				newSnapshot.tempoSet = tempoSet;
+				newSnapshot.tempo = _tempo;
+				newSnapshot.psecPerTick = _psecPerTick;
+				replayState->getEvents(newSnapshot.replayEvents);
+				_jumpSnapshots.push_back(newSnapshot);
+			}
 		}
 	}
 
@@ -529,7 +746,24 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 	return true;
 }
 
+const JumpSnapshot *MidiParser::findJumpSnapshot(uint32 tick) const {
+	// Find the last snapshot the scan for the given tick would pass;
+	// the scan stops at the first event at or after that tick.
+	uint lo = 0, hi = _jumpSnapshots.size();
+	while (lo < hi) {
+		uint mid = (lo + hi) / 2;
+		if (_jumpSnapshots[mid].position._lastEventTick < tick)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo > 0 ? &_jumpSnapshots[lo - 1] : nullptr;
+}
+
 void MidiParser::unloadMusic() {
+	_jumpSnapshots.clear();
+
 	if (_numTracks == 0)
 		// No music data loaded
 		return;
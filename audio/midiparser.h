@@ -25,6 +25,7 @@
 #define AUDIO_MIDIPARSER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/stream.h"
 
@@ -125,6 +126,29 @@ struct NoteTimer {
 	NoteTimer() : channel(0), note(0), timeLeft(0) {}
 };
 
+/**
+ * Parser state recorded while jumpToTick scans a track. A later jump
+ * can continue from the closest preceding snapshot instead of parsing
+ * the track from its start.
+ *
+ * Jumps which fire events replay replayEvents first. These are the
+ * events which still make up the controller, program, pitch bend and
+ * pressure state of each channel, the notes which are still on, and all
+ * SysEx and META events, in track order. Of several events setting the
+ * same state, only the last one is kept.
+ */
+struct JumpSnapshot {
+	Tracker position;      ///< The tracker state at the snapshot. Times exclude the ticks before the first tempo event.
+	EventInfo nextEvent;   ///< The pre-parsed event following the snapshot
+	uint32 eventIndex;     ///< The number of events parsed before the snapshot
+	uint32 initialTicks;   ///< The number of ticks parsed before the first tempo event
+	uint32 tempo;          ///< The tempo at the snapshot; only valid if tempoSet is true
+	uint32 psecPerTick;    ///< The microseconds per tick at the snapshot; only valid if tempoSet is true
+	bool   tempoSet;       ///< True if a tempo event was parsed before the snapshot
+	Common::Array<EventInfo> replayEvents; ///< The events to replay for jumps which fire events. SysEx and META data points into the track.
+	JumpSnapshot() : eventIndex(0), initialTicks(0), tempo(0), psecPerTick(0), tempoSet(false) {}
+};
+
 
 
 
@@ -289,6 +313,7 @@ struct NoteTimer {
 class MidiParser {
 protected:
 	static const uint8 MAXIMUM_TRACKS = 120;
+	static const uint32 JUMP_SNAPSHOT_INTERVAL = 256; ///< Number of parsed events between jump snapshots.
 
 	uint16    _activeNotes[128];   ///< Each uint16 is a bit mask for channels that have that note on.
 	NoteTimer _hangingNotes[32];   ///< Maintains expiration info for up to 32 notes.
@@ -320,6 +345,12 @@ protected:
 	bool   _doParse;       ///< True if the parser should be parsing; false if it should not be active
 	bool   _pause;		   ///< True if the parser has paused parsing
 
+	/**
+	 * Snapshots of the active track, ordered by tick. Only used if
+	 * supportsJumpSnapshots returns true.
+	 */
+	Common::Array<JumpSnapshot> _jumpSnapshots;
+
 	/**
 	 * The source number to use when sending MIDI messages to the driver.
 	 * When using multiple sources, use source 0 and higher. This must be
@@ -339,6 +370,7 @@ protected:
 	void activeNote(byte channel, byte note, bool active);
 	void hangingNote(byte channel, byte note, uint32 ticksLeft, bool recycle = true);
 	void hangAllActiveNotes();
+	const JumpSnapshot *findJumpSnapshot(uint32 tick) const;
 
 	/**
 	 * Called before starting playback of a track.
@@ -347,6 +379,16 @@ protected:
 	 */
 	virtual void onTrackStart(uint8 track) { };
 
+	/**
+	 * Returns true if the state of the parser at any point of a track is
+	 * fully described by the tracker, the pre-parsed next event and the
+	 * tempo. In that case jumpToTick records snapshots of this state and
+	 * uses them to speed up later jumps. Formats that keep additional
+	 * state while parsing, for example loop counters, must not enable
+	 * this.
+	 */
+	virtual bool supportsJumpSnapshots() const { return false; }
+
 	virtual void sendToDriver(uint32 b);
 	void sendToDriver(byte status, byte firstOp, byte secondOp) {
 		sendToDriver(status | ((uint32)firstOp << 8) | ((uint32)secondOp << 16));
@@ -22,6 +22,7 @@
 #include "gui/EventRecorder.h"
 
 #include "common/util.h"
+#include "common/tracing.h"
 #include "common/textconsole.h"
 
 #include "audio/mixer_intern.h"
@@ -32,6 +33,14 @@
 
 namespace Audio {
 
+/**
+ * Return the time used for the mixer statistics, in microseconds.
+ * The precision depends on the backend.
+ */
+static inline uint64 getStatsTime() {
+	return g_system->getMicros();
+}
+
 #pragma mark -
 #pragma mark --- Channel classes ---
 #pragma mark -
@@ -167,6 +176,16 @@ public:
 	 */
 	SoundHandle getHandle() const { return _handle; }
 
+	/**
+	 * Queries the statistics collected while mixing the channel.
+	 */
+	const Mixer::ChannelStats &getStats() const { return _stats; }
+
+	/**
+	 * Resets the statistics collected while mixing the channel.
+	 */
+	void resetStats();
+
 private:
 	const Mixer::SoundType _type;
 	SoundHandle _handle;
@@ -190,6 +209,8 @@ private:
 
 	RateConverter *_converter;
 	Common::DisposablePtr<AudioStream> _stream;
+
+	Mixer::ChannelStats _stats;
 };
 
 #pragma mark -
@@ -228,6 +249,36 @@ uint MixerImpl::getOutputBufSize() const {
 	return _outBufSize;
 }
 
+Mixer::Stats MixerImpl::getStats() const {
+	Common::StackLock lock(_mutex);
+	return _stats;
+}
+
+Common::Array<Mixer::ChannelStats> MixerImpl::getChannelStats() const {
+	Common::StackLock lock(_mutex);
+
+	Common::Array<ChannelStats> stats;
+	for (int i = 0; i != NUM_CHANNELS; i++)
+		if (_channels[i])
+			stats.push_back(_channels[i]->getStats());
+	return stats;
+}
+
+void MixerImpl::resetStats() {
+	Common::StackLock lock(_mutex);
+
+	_stats = Stats();
+	for (int i = 0; i != NUM_CHANNELS; i++)
+		if (_channels[i])
+			_channels[i]->resetStats();
+}
+
+void MixerImpl::reportOutputUnderrun() {
+	Common::StackLock lock(_mutex);
+	_stats.outputUnderruns++;
+	TRACE_COUNTER("Mixer output underruns", _stats.outputUnderruns);
+}
+
 void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	int index = -1;
 	for (int i = 0; i != NUM_CHANNELS; i++) {
@@ -299,6 +350,8 @@ void MixerImpl::playStream(
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
+	TRACE_ZONE("MixerImpl::mixCallback");
+
 	assert(samples);
 
 	Common::StackLock lock(_mutex);
@@ -320,21 +373,38 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 		len >>= 1;
 	}
 
+	const uint64 mixStart = getStatsTime();
+
 	// mix all channels
 	int res = 0, tmp;
+	uint activeChannels = 0;
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
 				delete _channels[i];
 				_channels[i] = nullptr;
 			} else if (!_channels[i]->isPaused()) {
+				const uint32 starved = _channels[i]->getStats().starved;
 				tmp = _channels[i]->mix(buf, len);
+				_stats.starvedChannels += _channels[i]->getStats().starved - starved;
+				activeChannels++;
 
 				if (tmp > res)
 					res = tmp;
 			}
 		}
 
+	const uint32 mixTime = getStatsTime() - mixStart;
+	_stats.callbacks++;
+	_stats.lastMixTime = mixTime;
+	_stats.maxMixTime = MAX(_stats.maxMixTime, mixTime);
+	_stats.totalMixTime += mixTime;
+	_stats.peakActiveChannels = MAX(_stats.peakActiveChannels, activeChannels);
+	if ((uint64)mixTime * _sampleRate > (uint64)len * 1000000)
+		_stats.overBudgetCallbacks++;
+
+	TRACE_COUNTER("Mixer active channels", activeChannels);
+
 	return res;
 }
 
@@ -583,6 +653,10 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 
 	// Get a rate converter instance
 	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo);
+
+	_stats.id = id;
+	_stats.type = type;
+	resetStats();
 }
 
 Channel::~Channel() {
@@ -708,9 +782,13 @@ void Channel::loop() {
 }
 
 int Channel::mix(int16 *data, uint len) {
+	TRACE_ZONE("Channel::mix");
+
 	assert(_stream);
 	assert(_converter);
 
+	const uint64 mixStart = getStatsTime();
+
 	int res = 0;
 	if (!_stream->endOfData() || _converter->needsDraining()) {
 		_samplesConsumed = _samplesDecoded;
@@ -720,7 +798,24 @@ int Channel::mix(int16 *data, uint len) {
 		_samplesDecoded += res;
 	}
 
+	// A stream which has no data yet, but has not ended either, is
+	// fed too slowly, e.g. a queue filled by a video decoder.
+	if ((uint)res < len && !_stream->endOfStream())
+		_stats.starved++;
+
+	const uint32 mixTime = getStatsTime() - mixStart;
+	_stats.mixes++;
+	_stats.maxMixTime = MAX(_stats.maxMixTime, mixTime);
+	_stats.totalMixTime += mixTime;
+
 	return res;
 }
 
+void Channel::resetStats() {
+	_stats.mixes = 0;
+	_stats.starved = 0;
+	_stats.maxMixTime = 0;
+	_stats.totalMixTime = 0;
+}
+
 } // End of namespace Audio
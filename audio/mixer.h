@@ -22,6 +22,7 @@
 #ifndef AUDIO_MIXER_H
 #define AUDIO_MIXER_H
 
+#include "common/array.h"
 #include "common/mutex.h"
 #include "common/types.h"
 #include "common/noncopyable.h"
@@ -345,6 +346,56 @@ public:
 	 * @return The number of samples processed at each audio callback.
 	 */
 	virtual uint getOutputBufSize() const = 0;
+
+	/**
+	 * Statistics about the audio output, collected since the mixer was
+	 * created or resetStats() was called.
+	 *
+	 * Times are in microseconds, as measured by OSystem::getMicros(),
+	 * so their precision depends on the backend.
+	 */
+	struct Stats {
+		uint32 callbacks;          ///< Number of mixer callbacks.
+		uint32 outputUnderruns;    ///< Callbacks which came too late to keep the output device busy, as detected by the backend.
+		uint32 starvedChannels;    ///< Number of times a channel ran out of samples before its stream ended.
+		uint32 overBudgetCallbacks; ///< Callbacks which took longer than the audio they produced lasts.
+		uint peakActiveChannels;   ///< Highest number of channels mixed in one callback.
+		uint32 lastMixTime;        ///< Time spent in the last callback.
+		uint32 maxMixTime;         ///< Longest time spent in one callback.
+		uint64 totalMixTime;       ///< Time spent in all callbacks.
+
+		Stats() : callbacks(0), outputUnderruns(0), starvedChannels(0), overBudgetCallbacks(0),
+			peakActiveChannels(0), lastMixTime(0), maxMixTime(0), totalMixTime(0) {}
+	};
+
+	/**
+	 * Statistics about a channel, collected since it was started or
+	 * resetStats() was called. Mix times include decoding and rate
+	 * conversion of its stream.
+	 */
+	struct ChannelStats {
+		int id;                    ///< The ID of the channel, or -1 if it has none.
+		SoundType type;            ///< The sound type of the channel.
+		uint32 mixes;              ///< Number of callbacks in which the channel was mixed.
+		uint32 starved;            ///< Number of times the channel ran out of samples before its stream ended.
+		uint32 maxMixTime;         ///< Longest time spent mixing the channel in one callback.
+		uint64 totalMixTime;       ///< Time spent mixing the channel.
+	};
+
+	/**
+	 * Return the statistics about the audio output.
+	 */
+	virtual Stats getStats() const = 0;
+
+	/**
+	 * Return the statistics about all active channels.
+	 */
+	virtual Common::Array<ChannelStats> getChannelStats() const = 0;
+
+	/**
+	 * Reset the statistics about the audio output and all active channels.
+	 */
+	virtual void resetStats() = 0;
 };
 
 /** @} */
@@ -79,6 +79,8 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	Stats _stats;
+
 
 public:
 
@@ -136,6 +138,10 @@ public:
 	virtual bool getOutputStereo() const;
 	virtual uint getOutputBufSize() const;
 
+	virtual Stats getStats() const;
+	virtual Common::Array<ChannelStats> getChannelStats() const;
+	virtual void resetStats();
+
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
@@ -151,6 +157,13 @@ public:
 	 */
 	int mixCallback(byte *samples, uint len);
 
+	/**
+	 * Report that the output device ran out of samples. Backends which
+	 * can detect this should call it from their audio callback, so it
+	 * shows up in the statistics.
+	 */
+	void reportOutputUnderrun();
+
 	/**
 	 * Set the internal 'is ready' flag of the mixer.
 	 * Backends should invoke Mixer::setReady(true) once initialisation of
@@ -33,11 +33,11 @@
 #include <math.h>
 
 #include "common/scummsys.h"
-#include "common/translation.h"
+#include "common/textconsole.h"
 
 #include "audio/mixer.h"
+#include "audio/decoders/raw.h"
 #include "audio/mods/paula.h"
-#include "audio/null.h"
 
 namespace Audio {
 
@@ -93,16 +93,28 @@ int Paula::readBuffer(int16 *buffer, const int numSamples) {
 	}
 
 	if (_stereo)
-		return readBufferIntern<true>(buffer, numSamples);
+		return readBufferIntern<true>(buffer, numSamples, false);
 	else
-		return readBufferIntern<false>(buffer, numSamples);
+		return readBufferIntern<false>(buffer, numSamples, false);
+}
+
+int Paula::renderBuffer(int16 *buffer, const int numSamples) {
+	memset(buffer, 0, numSamples * 2);
+	if (!_playing)
+		return 0;
+
+	if (_stereo)
+		return readBufferIntern<true>(buffer, numSamples, true);
+	else
+		return readBufferIntern<false>(buffer, numSamples, true);
 }
 
 /* Denormals are very small floating point numbers that force FPUs into slow
  * mode. All lowpass filters using floats are suspectible to denormals unless
  * a small offset is added to avoid very small floating point numbers.
+ * It is a float, so the filters are not computed in double precision.
  */
-#define DENORMAL_OFFSET (1E-10)
+#define DENORMAL_OFFSET (1E-10f)
 
 /* Based on UAE.
  * Original comment in UAE:
@@ -122,30 +134,31 @@ int Paula::readBuffer(int16 *buffer, const int numSamples) {
  * The current filtering should be accurate to 2 dB with the filter on,
  * and to 1 dB with the filter off.
  */
-inline int32 filter(int32 input, Paula::FilterState &state, int voice) {
+template<Paula::FilterMode filterMode>
+inline int32 filter(int32 input, const float *a0, float *rc, bool ledFilter) {
 	float normalOutput, ledOutput;
 
-	switch (state.mode) {
+	switch (filterMode) {
 	case Paula::kFilterModeA500:
-		state.rc[voice][0] = state.a0[0] * input + (1 - state.a0[0]) * state.rc[voice][0] + DENORMAL_OFFSET;
-		state.rc[voice][1] = state.a0[1] * state.rc[voice][0] + (1-state.a0[1]) * state.rc[voice][1];
-		normalOutput = state.rc[voice][1];
+		rc[0] = a0[0] * input + (1 - a0[0]) * rc[0] + DENORMAL_OFFSET;
+		rc[1] = a0[1] * rc[0] + (1-a0[1]) * rc[1];
+		normalOutput = rc[1];
 
-		state.rc[voice][2] = state.a0[2] * normalOutput        + (1 - state.a0[2]) * state.rc[voice][2];
-		state.rc[voice][3] = state.a0[2] * state.rc[voice][2]  + (1 - state.a0[2]) * state.rc[voice][3];
-		state.rc[voice][4] = state.a0[2] * state.rc[voice][3]  + (1 - state.a0[2]) * state.rc[voice][4];
+		rc[2] = a0[2] * normalOutput + (1 - a0[2]) * rc[2];
+		rc[3] = a0[2] * rc[2]        + (1 - a0[2]) * rc[3];
+		rc[4] = a0[2] * rc[3]        + (1 - a0[2]) * rc[4];
 
-		ledOutput = state.rc[voice][4];
+		ledOutput = rc[4];
 		break;
 
 	case Paula::kFilterModeA1200:
 		normalOutput = input;
 
-		state.rc[voice][1] = state.a0[2] * normalOutput        + (1 - state.a0[2]) * state.rc[voice][1] + DENORMAL_OFFSET;
-		state.rc[voice][2] = state.a0[2] * state.rc[voice][1]  + (1 - state.a0[2]) * state.rc[voice][2];
-		state.rc[voice][3] = state.a0[2] * state.rc[voice][2]  + (1 - state.a0[2]) * state.rc[voice][3];
+		rc[1] = a0[2] * normalOutput + (1 - a0[2]) * rc[1] + DENORMAL_OFFSET;
+		rc[2] = a0[2] * rc[1]        + (1 - a0[2]) * rc[2];
+		rc[3] = a0[2] * rc[2]        + (1 - a0[2]) * rc[3];
 
-		ledOutput = state.rc[voice][3];
+		ledOutput = rc[3];
 		break;
 
 	case Paula::kFilterModeNone:
@@ -154,33 +167,77 @@ inline int32 filter(int32 input, Paula::FilterState &state, int voice) {
 
 	}
 
-	return CLIP<int32>(state.ledFilter ? ledOutput : normalOutput, -32768, 32767);
+	return CLIP<int32>(ledFilter ? ledOutput : normalOutput, -32768, 32767);
 }
 
-template<bool stereo>
-inline int mixBuffer(int16 *&buf, const int8 *data, Paula::Offset &offset, frac_t rate, int neededSamples, uint bufSize, byte volume, byte panning, Paula::FilterState &filterState, int voice) {
-	int samples;
-	for (samples = 0; samples < neededSamples && offset.int_off < bufSize; ++samples) {
-		const int32 tmp = filter(((int32) data[offset.int_off]) * volume, filterState, voice);
+/**
+ * Mix a block of samples of one voice, up to the end of its sample data.
+ *
+ * Period, volume and filter settings only change between blocks, from
+ * interrupts, so they are set up once per block. The number of samples
+ * left in the sample data is computed up front as well, leaving the
+ * loop with nothing but the per sample work.
+ */
+template<bool stereo, Paula::FilterMode filterMode>
+int mixBuffer(int16 *&buf, const int8 *data, Paula::Offset &offset, frac_t rate, int neededSamples, uint bufSize, byte volume, byte panning, Paula::FilterState &filterState, int voice) {
+	if (offset.int_off >= bufSize)
+		return 0;
+
+	// The offset is stepped by rate per sample, stop before it reaches bufSize
+	int samples = neededSamples;
+	if (rate > 0) {
+		const uint64 distance = ((uint64)(bufSize - offset.int_off) << FRAC_BITS) - offset.rem_off;
+		const uint64 steps = (distance + rate - 1) / rate;
+		if (steps < (uint64)samples)
+			samples = (int)steps;
+	}
+
+	// Without filtering, the volume can be folded into the panning factors
+	const bool filtered = filterMode != Paula::kFilterModeNone;
+	const int32 scale = filtered ? 1 : volume;
+	const int32 left = (255 - panning) * scale;
+	const int32 right = panning * scale;
+
+	const float *a0 = filterState.a0;
+	const bool ledFilter = filterState.ledFilter;
+	float rc[5];
+	if (filtered)
+		memcpy(rc, filterState.rc[voice], sizeof(rc));
+
+	uint intOff = offset.int_off;
+	frac_t remOff = offset.rem_off;
+	int16 *p = buf;
+	for (int i = 0; i < samples; ++i) {
+		int32 tmp = data[intOff];
+		if (filtered)
+			tmp = filter<filterMode>(tmp * volume, a0, rc, ledFilter);
+
 		if (stereo) {
-			*buf++ += (tmp * (255 - panning)) >> 7;
-			*buf++ += (tmp * (panning)) >> 7;
-		} else
-			*buf++ += tmp;
+			*p++ += (tmp * left) >> 7;
+			*p++ += (tmp * right) >> 7;
+		} else {
+			*p++ += tmp * scale;
+		}
 
 		// Step to next source sample
-		offset.rem_off += rate;
-		if (offset.rem_off >= (frac_t)FRAC_ONE) {
-			offset.int_off += fracToInt(offset.rem_off);
-			offset.rem_off &= FRAC_LO_MASK;
-		}
+		remOff += rate;
+		intOff += fracToInt(remOff);
+		remOff &= FRAC_LO_MASK;
 	}
 
+	if (filtered)
+		memcpy(filterState.rc[voice], rc, sizeof(rc));
+
+	buf = p;
+	offset.int_off = intOff;
+	offset.rem_off = remOff;
 	return samples;
 }
 
 template<bool stereo>
-int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
+int Paula::readBufferIntern(int16 *buffer, const int numSamples, bool stopAtEnd) {
+	typedef int (*MixFunc)(int16 *&, const int8 *, Offset &, frac_t, int, uint, byte, byte, FilterState &, int);
+
 	int samples = stereo ? numSamples / 2 : numSamples;
 	while (samples > 0) {
 
@@ -189,6 +246,23 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 		if (_curInt == 0) {
 			_curInt = _intFreq;
 			interrupt();
+
+			if (stopAtEnd && !_playing)
+				return numSamples - (stereo ? samples * 2 : samples);
+		}
+
+		MixFunc mix;
+		switch (_filterState.mode) {
+		case kFilterModeA500:
+			mix = &mixBuffer<stereo, kFilterModeA500>;
+			break;
+		case kFilterModeA1200:
+			mix = &mixBuffer<stereo, kFilterModeA1200>;
+			break;
+		case kFilterModeNone:
+		default:
+			mix = &mixBuffer<stereo, kFilterModeNone>;
+			break;
 		}
 
 		// Compute how many samples to generate: at most the requested number of samples,
@@ -225,7 +299,7 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 			// by the OS/2 version of Hopkins FBI.
 
 			// Mix the generated samples into the output buffer
-			neededSamples -= mixBuffer<stereo>(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume, ch.panning, _filterState, voice);
+			neededSamples -= mix(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume, ch.panning, _filterState, voice);
 
 			// Wrap around if necessary
 			if (ch.offset.int_off >= ch.length) {
@@ -256,7 +330,7 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 				// Repeat as long as necessary.
 				while (neededSamples > 0) {
 					// Mix the generated samples into the output buffer
-					neededSamples -= mixBuffer<stereo>(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume, ch.panning, _filterState, voice);
+					neededSamples -= mix(p, ch.data, ch.offset, rate, neededSamples, ch.length, ch.volume, ch.panning, _filterState, voice);
 
 					if (ch.offset.int_off >= ch.length) {
 						// Wrap around. See also the note above.
@@ -274,6 +348,52 @@ int Paula::readBufferIntern(int16 *buffer, const int numSamples) {
 	return numSamples;
 }
 
+SeekableAudioStream *renderPaulaStream(Paula *paula, uint32 maxMillis, DisposeAfterUse::Flag disposeAfterUse) {
+	const uint channels = paula->isStereo() ? 2 : 1;
+	const uint32 maxSamples = (uint64)paula->getRate() * maxMillis / 1000 * channels;
+	// Render a second at a time, most modules stop long before the limit
+	const uint32 chunkSamples = paula->getRate() * channels;
+
+	int16 *data = nullptr;
+	uint32 size = 0;
+	uint32 samples = 0;
+	while (samples < maxSamples) {
+		const uint32 count = MIN(chunkSamples, maxSamples - samples);
+		if (samples + count > size) {
+			size = MIN(MAX(size * 2, samples + count), maxSamples);
+			int16 *newData = (int16 *)realloc(data, size * sizeof(int16));
+			if (!newData) {
+				warning("renderPaulaStream: Could not allocate %u samples", size);
+				free(data);
+				data = nullptr;
+				break;
+			}
+			data = newData;
+		}
+
+		const int rendered = paula->renderBuffer(data + samples, count);
+		samples += rendered;
+		if ((uint32)rendered < count)
+			break;
+	}
+
+	const int rate = paula->getRate();
+	if (disposeAfterUse == DisposeAfterUse::YES)
+		delete paula;
+
+	if (!data)
+		return nullptr;
+
+	byte flags = FLAG_16BITS;
+	if (channels == 2)
+		flags |= FLAG_STEREO;
+#ifdef SCUMM_LITTLE_ENDIAN
+	flags |= FLAG_LITTLE_ENDIAN;
+#endif
+
+	return makeRawStream((const byte *)data, samples * sizeof(int16), rate, flags, DisposeAfterUse::YES);
+}
+
 void Paula::filterResetState() {
 	for (int i = 0; i < NUM_VOICES; i++)
 		for (int j = 0; j < 5; j++)
@@ -301,34 +421,3 @@ float Paula::filterCalculateA0(int rate, int cutoff) {
 }
 
 } // End of namespace Audio
-
-
-//	Plugin interface
-//	(This can only create a null driver since apple II gs support seeems not to be implemented
-//  and also is not part of the midi driver architecture. But we need the plugin for the options
-//  menu in the launcher and for MidiDriver::detectDevice() which is more or less used by all engines.)
-
-class AmigaMusicPlugin : public NullMusicPlugin {
-public:
-	const char *getName() const override {
-		return _s("Amiga Audio emulator");
-	}
-
-	const char *getId() const override {
-		return "amiga";
-	}
-
-	MusicDevices getDevices() const override;
-};
-
-MusicDevices AmigaMusicPlugin::getDevices() const {
-	MusicDevices devices;
-	devices.push_back(MusicDevice(this, "", MT_AMIGA));
-	return devices;
-}
-
-//#if PLUGIN_ENABLED_DYNAMIC(AMIGA)
-	//REGISTER_PLUGIN_DYNAMIC(AMIGA, PLUGIN_TYPE_MUSIC, AmigaMusicPlugin);
-//#else
-	REGISTER_PLUGIN_STATIC(AMIGA, PLUGIN_TYPE_MUSIC, AmigaMusicPlugin);
-//#endif
@@ -104,6 +104,19 @@ public:
 	bool endOfData() const { return _end; }
 	int getRate() const { return _rate; }
 
+	/**
+	 * Render samples like readBuffer(), but without locking the mixer,
+	 * and stopping once playback stops. This is meant for rendering music
+	 * ahead of time, which is a lot faster than real time.
+	 *
+	 * The player must not be played by the mixer or be modified by other
+	 * threads meanwhile.
+	 *
+	 * @return The number of samples rendered, which is less than
+	 *         numSamples if playback stopped.
+	 */
+	int renderBuffer(int16 *buffer, const int numSamples);
+
 protected:
 	struct Channel {
 		const int8 *data;
@@ -233,12 +246,29 @@ private:
 	FilterState _filterState;
 
 	template<bool stereo>
-	int readBufferIntern(int16 *buffer, const int numSamples);
+	int readBufferIntern(int16 *buffer, const int numSamples, bool stopAtEnd);
 
 	void filterResetState();
 	float filterCalculateA0(int rate, int cutoff);
 };
 
+/**
+ * Render a Paula based player, like the ProTracker one, to PCM ahead of
+ * time, e.g. to cache the music of a game. This is a lot faster than
+ * playing it in real time.
+ *
+ * Rendering stops when the player stops playback, or after maxMillis.
+ * Modules which loop never stop, so the limit should be chosen with care.
+ *
+ * @param paula            The player to render. It must not be played by
+ *                         the mixer.
+ * @param maxMillis        The maximum length to render, in milliseconds.
+ * @param disposeAfterUse  Whether to delete the player after rendering.
+ * @return A stream playing the rendered samples, or nullptr if memory
+ *         for them could not be allocated.
+ */
+SeekableAudioStream *renderPaulaStream(Paula *paula, uint32 maxMillis, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
 } // End of namespace Audio
 
 #endif
@@ -67,6 +67,7 @@ MODULE_OBJS := \
 	softsynth/fmtowns_pc98/towns_pc98_driver.o \
 	softsynth/fmtowns_pc98/towns_pc98_fmsynth.o \
 	softsynth/fmtowns_pc98/towns_pc98_plugins.o \
+	softsynth/amiga.o \
 	softsynth/appleiigs.o \
 	softsynth/fluidsynth.o \
 	softsynth/mt32.o \
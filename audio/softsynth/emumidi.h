@@ -25,6 +25,7 @@
 #include "audio/audiostream.h"
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
+#include "common/config-manager.h"
 
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
@@ -43,12 +44,41 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	Audio::AudioStream *_renderAheadStream;
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Start playing the driver on the mixer. The "synth_render_ahead" setting
+	 * lets the synth render ahead of playback from the timer thread, for
+	 * synths too expensive to render in the mixer callback. The rendering
+	 * time is then spent on the timer thread, delaying the other timer
+	 * procs, see Audio::makeRenderAheadStream().
+	 */
+	void startPlayback() {
+		Audio::AudioStream *stream = this;
+
+		int renderAhead = ConfMan.getInt("synth_render_ahead");
+		if (renderAhead > 0)
+			stream = _renderAheadStream = Audio::makeRenderAheadStream(this, renderAhead, DisposeAfterUse::NO);
+
+		_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, stream, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+	}
+
+	/**
+	 * Stop playing the driver. Afterwards, the synth is not rendered anymore.
+	 */
+	void stopPlayback() {
+		_mixer->stopHandle(_mixerSoundHandle);
+
+		delete _renderAheadStream;
+		_renderAheadStream = nullptr;
+	}
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -57,6 +87,7 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_renderAheadStream(nullptr),
 		_baseFreq(250) {
 	}
 
@@ -489,7 +489,7 @@ int MidiDriver_FluidSynth::open() {
 
 	MidiDriver_Emulated::open();
 
-	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+	startPlayback();
 
 	return 0;
 }
@@ -499,7 +499,7 @@ void MidiDriver_FluidSynth::close() {
 		return;
 	_isOpen = false;
 
-	_mixer->stopHandle(_mixerSoundHandle);
+	stopPlayback();
 
 	if (_soundFont != -1)
 		fluid_synth_sfunload(_synth, _soundFont, 1);
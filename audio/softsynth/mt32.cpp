@@ -220,7 +220,7 @@ int MidiDriver_MT32::open() {
 
 	MidiDriver_Emulated::open();
 
-	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
+	startPlayback();
 
 	return 0;
 }
@@ -271,7 +271,7 @@ void MidiDriver_MT32::close() {
 	// Detach the player callback handler
 	setTimerCallback(nullptr, nullptr);
 	// Detach the mixer callback handler
-	_mixer->stopHandle(_mixerSoundHandle);
+	stopPlayback();
 
 	Common::StackLock lock(_mutex);
 	_service.closeSynth();
@@ -25,7 +25,9 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/savefile.h"
 #include "common/translation.h"
+#include "common/tracing.h"
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/action.h"
 #include "backends/keymapper/keymapper.h"
@@ -80,8 +82,15 @@ void DefaultEventManager::init() {
 }
 
 bool DefaultEventManager::pollEvent(Common::Event &event) {
+	TRACE_ZONE("EventManager::pollEvent");
+
 	_dispatcher.dispatch();
 
+	// Write save files which were compressed in the background
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	if (saveFileMan)
+		saveFileMan->handleBackgroundSaves();
+
 	if (g_engine)
 		// Handle autosaves if enabled
 		g_engine->handleAutoSave();
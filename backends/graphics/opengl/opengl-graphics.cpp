@@ -30,6 +30,7 @@
 #include "graphics/opengl/debug.h"
 
 #include "common/array.h"
+#include "common/debug.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/algorithm.h"
@@ -678,6 +679,9 @@ void OpenGLGraphicsManager::updateScreen() {
 	}
 	_overlay->updateGLTexture();
 
+	debug(9, "OpenGL: Uploaded %u bytes of texture data", GLTexture::getUploadedBytes());
+	GLTexture::resetUploadedBytes();
+
 #if !USE_FORCED_GLES
 	if (_libretroPipeline) {
 		_libretroPipeline->beginScaling();
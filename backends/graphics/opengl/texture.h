@@ -28,6 +28,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 class Scaler;
@@ -114,6 +115,13 @@ public:
 	 */
 	void updateArea(const Common::Rect &area, const Graphics::Surface &src);
 
+	/**
+	 * Query the number of bytes uploaded by all textures since the last
+	 * call to resetUploadedBytes().
+	 */
+	static uint32 getUploadedBytes() { return _uploadedBytes; }
+	static void resetUploadedBytes() { _uploadedBytes = 0; }
+
 	/**
 	 * Query the GL texture's width.
 	 */
@@ -158,6 +166,8 @@ private:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+
+	static uint32 _uploadedBytes;
 };
 
 /**
@@ -224,7 +234,7 @@ public:
 	void fill(const Common::Rect &r, uint32 color);
 
 	void flagDirty() { _allDirty = true; }
-	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
+	virtual bool isDirty() const { return _allDirty || !_dirtyRects.empty(); }
 
 	virtual uint getWidth() const = 0;
 	virtual uint getHeight() const = 0;
@@ -264,13 +274,22 @@ public:
 	 */
 	virtual const GLTexture &getGLTexture() const = 0;
 protected:
-	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
+	void clearDirty() { _allDirty = false; _dirtyRects.clear(); }
 
 	void addDirtyArea(const Common::Rect &r);
+
+	/**
+	 * @return The bounding box of all dirty areas.
+	 */
 	Common::Rect getDirtyArea() const;
+
+	/**
+	 * @return The dirty areas, they don't overlap each other.
+	 */
+	Common::Array<Common::Rect> getDirtyRects() const;
 private:
 	bool _allDirty;
-	Common::Rect _dirtyArea;
+	Common::Array<Common::Rect> _dirtyRects;
 };
 
 /**
@@ -314,7 +333,7 @@ public:
 protected:
 	const Graphics::PixelFormat _format;
 
-	void updateGLTexture(Common::Rect &dirtyArea);
+	void updateGLTexture(Common::Array<Common::Rect> &dirtyRects);
 
 private:
 	GLTexture _glTexture;
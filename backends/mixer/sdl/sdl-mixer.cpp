@@ -39,7 +39,7 @@
 #define SAMPLES_PER_SEC 44100
 #endif
 
-SdlMixerManager::SdlMixerManager() : _isSubsystemInitialized(false), _isAudioOpen(false) {
+SdlMixerManager::SdlMixerManager() : _isSubsystemInitialized(false), _isAudioOpen(false), _lastCallbackTime(0) {
 }
 
 SdlMixerManager::~SdlMixerManager() {
@@ -197,11 +197,22 @@ SDL_AudioSpec SdlMixerManager::getAudioSpec(uint32 outputRate) {
 
 void SdlMixerManager::startAudio() {
 	// Start the sound system
+	_lastCallbackTime = 0;
 	SDL_PauseAudio(0);
 }
 
 void SdlMixerManager::callbackHandler(byte *samples, int len) {
 	assert(_mixer);
+
+	// SDL buffers at least one more callback worth of samples, so if the
+	// previous callback was more than two of them ago, the output device
+	// ran dry in between.
+	const uint32 now = g_system->getMillis(true);
+	const uint32 callbackMillis = len * 1000 / (_obtained.freq * _obtained.channels * 2);
+	if (_lastCallbackTime && now - _lastCallbackTime > 2 * callbackMillis + 1)
+		_mixer->reportOutputUnderrun();
+	_lastCallbackTime = now;
+
 	_mixer->mixCallback(samples, len);
 }
 
@@ -223,6 +234,7 @@ int SdlMixerManager::resumeAudio() {
 	if (SDL_OpenAudio(&_obtained, nullptr) < 0) {
 		return -1;
 	}
+	_lastCallbackTime = 0;
 	SDL_PauseAudio(0);
 	_audioSuspended = false;
 	return 0;
@@ -83,6 +83,12 @@ protected:
 
 	bool _isSubsystemInitialized;
 	bool _isAudioOpen;
+
+	/**
+	 * The time of the last audio callback, used to detect output
+	 * underruns. 0 if there was none since audio was (re)started.
+	 */
+	uint32 _lastCallbackTime;
 };
 
 #endif
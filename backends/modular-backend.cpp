@@ -27,6 +27,7 @@
 #include "gui/EventRecorder.h"
 
 #include "common/timer.h"
+#include "common/tracing.h"
 #include "graphics/pixelformat.h"
 
 ModularGraphicsBackend::ModularGraphicsBackend()
@@ -184,6 +185,8 @@ void ModularGraphicsBackend::fillScreen(const Common::Rect &r, uint32 col) {
 }
 
 void ModularGraphicsBackend::updateScreen() {
+	TRACE_ZONE("OSystem::updateScreen");
+
 #ifdef ENABLE_EVENTRECORDER
 	g_system->getMillis();		// force event recorder to update the tick count
 	g_eventRec.processScreenUpdate();
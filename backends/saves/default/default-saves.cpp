@@ -37,19 +37,97 @@
 #include "common/archive.h"
 #include "common/config-manager.h"
 #include "common/compression/deflate.h"
+#include "common/memstream.h"
+#include "common/timer.h"
 
 #include <errno.h>	// for removeSavefile()
+#include <stdio.h>	// for renameFile()
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 const char *const DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+/**
+ * Suffix of the file a background save is written to, until it is complete
+ * and renamed to its actual name.
+ */
+static const char *const BACKGROUND_SAVE_SUFFIX = ".partial";
+
+struct DefaultSaveFileManager::BackgroundSave {
+	Common::String name;
+	Common::Path savePath;
+	Common::FSNode fileNode;
+	Common::FSNode tempNode;
+	byte *data;     ///< Data to write, replaced by the compressed data once ready
+	uint32 size;
+	uint32 compressed; ///< Bytes of data passed to the compressor so far
+	Common::MemoryWriteStreamDynamic *output;
+	Common::WriteStream *compressor;
+	bool ready;     ///< Whether the data can be written to disk
+	bool failed;
+
+	BackgroundSave() : data(nullptr), size(0), compressed(0), output(nullptr), compressor(nullptr), ready(false), failed(false) {}
+
+	~BackgroundSave() {
+		// The compressor owns the output stream, but not its data.
+		if (compressor)
+			free(output->getData());
+		delete compressor;
+		free(data);
+	}
+};
+
+/**
+ * Buffers a save file in memory, and hands it over to the save file
+ * manager to be written in the background once finalized.
+ */
+class BackgroundOutSaveFile : public Common::OutSaveFile {
+public:
+	BackgroundOutSaveFile(DefaultSaveFileManager *manager, const Common::String &name, bool compress) :
+		Common::OutSaveFile(new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO)),
+		_manager(manager), _name(name), _compress(compress), _finalized(false) {}
+
+	~BackgroundOutSaveFile() override {
+		if (!_finalized)
+			free(getBuffer()->getData());
+	}
+
+	void finalize() override {
+		// Engines usually finalize again after appendExtendedSave() did.
+		if (_finalized)
+			return;
+		_finalized = true;
+
+		// The manager takes over the buffer, and frees it once written.
+		Common::MemoryWriteStreamDynamic *buffer = getBuffer();
+		_manager->queueBackgroundSave(_name, buffer->getData(), buffer->size(), _compress);
+	}
+
+private:
+	Common::MemoryWriteStreamDynamic *getBuffer() {
+		return static_cast<Common::MemoryWriteStreamDynamic *>(_wrapped);
+	}
+
+	DefaultSaveFileManager *_manager;
+	Common::String _name;
+	bool _compress;
+	bool _finalized;
+};
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _nextSaveFileRevision(0), _backgroundSaveTimerInstalled(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) : _nextSaveFileRevision(0), _backgroundSaveTimerInstalled(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	flushBackgroundSaves();
+
+	// The timer manager may already be gone when the backend shuts down.
+	Common::TimerManager *manager = g_system->getTimerManager();
+	if (_backgroundSaveTimerInstalled && manager)
+		manager->removeTimerProc(&backgroundSaveTimer);
+}
 
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
@@ -92,6 +170,9 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	// The file may not have been written yet.
+	flushBackgroundSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -108,6 +189,9 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	// The file may not have been written yet.
+	flushBackgroundSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -129,16 +213,16 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 	}
 }
 
-Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+bool DefaultSaveFileManager::prepareSaving(const Common::String &filename, Common::FSNode &fileNode) {
 	// Assure the savefile name cache is up-to-date.
 	const Common::Path savePathName = getSavePath();
 	assureCached(savePathName);
 	if (getError().getCode() != Common::kNoError)
-		return nullptr;
+		return false;
 
 	for (Common::StringArray::const_iterator i = _lockedFiles.begin(), end = _lockedFiles.end(); i != end; ++i) {
 		if (filename == *i) {
-			return nullptr; //file is locked, no saving available
+			return false; //file is locked, no saving available
 		}
 	}
 
@@ -151,7 +235,6 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 	// Obtain node.
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
-	Common::FSNode fileNode;
 
 	// If the file did not exist before, we add it to the cache.
 	if (file == _saveFileCache.end()) {
@@ -161,6 +244,17 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 		fileNode = file->_value;
 	}
 
+	return true;
+}
+
+Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	// Pending background saves of this file must not overwrite it later.
+	flushBackgroundSaves();
+
+	Common::FSNode fileNode;
+	if (!prepareSaving(filename, fileNode))
+		return nullptr;
+
 	// Open the file for saving.
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
@@ -169,11 +263,184 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
+	_saveFileRevisions.erase(filename);
 
 	return result;
 }
 
+Common::OutSaveFile *DefaultSaveFileManager::openForSavingInBackground(const Common::String &filename, bool compress) {
+	// Do the checks now, so that failures are reported right away.
+	Common::FSNode fileNode;
+	if (!prepareSaving(filename, fileNode))
+		return nullptr;
+
+	return new BackgroundOutSaveFile(this, filename, compress);
+}
+
+void DefaultSaveFileManager::queueBackgroundSave(const Common::String &filename, byte *data, uint32 size, bool compress) {
+	BackgroundSave *save = new BackgroundSave();
+	save->name = filename;
+	save->data = data;
+	save->size = size;
+
+	if (compress) {
+		save->output = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		save->compressor = Common::wrapCompressedWriteStream(save->output);
+	} else {
+		save->ready = true;
+	}
+
+	save->savePath = getSavePath();
+
+	// Errors are reported once writing fails.
+	assureCached(save->savePath);
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end()) {
+		const Common::FSNode savePath(save->savePath);
+		save->fileNode = savePath.getChild(filename);
+	} else {
+		save->fileNode = file->_value;
+	}
+	save->tempNode = save->fileNode.getParent().getChild(filename + BACKGROUND_SAVE_SUFFIX);
+
+	// The file is listed right away, loading it waits for it to be written.
+	_saveFileCache[filename] = Common::FSNode(save->fileNode.getPath());
+	_saveFileRevisions.erase(filename);
+
+	_backgroundSaveMutex.lock();
+	_backgroundSaves.push_back(save);
+	_backgroundSaveMutex.unlock();
+
+	// Never install the timer while holding the mutex: the timer manager
+	// holds its own one while calling backgroundSaveTimer().
+	if (!_backgroundSaveTimerInstalled) {
+		Common::TimerManager *manager = g_system->getTimerManager();
+		_backgroundSaveTimerInstalled = manager && manager->installTimerProc(&backgroundSaveTimer, kBackgroundSaveInterval, this, "DefaultSaveFileManager");
+	}
+
+	if (!_backgroundSaveTimerInstalled)
+		flushBackgroundSaves();
+}
+
+bool DefaultSaveFileManager::compressBackgroundSave(BackgroundSave &save, uint32 maxBytes) {
+	uint32 count = save.size - save.compressed;
+	if (maxBytes && count > maxBytes)
+		count = maxBytes;
+
+	if (save.compressor->write(save.data + save.compressed, count) != count) {
+		save.failed = true;
+	} else {
+		save.compressed += count;
+		if (save.compressed < save.size)
+			return false;
+
+		save.compressor->finalize();
+		save.failed = save.compressor->err();
+	}
+
+	// Deleting the compressor keeps the compressed data.
+	free(save.data);
+	save.data = save.output->getData();
+	save.size = save.output->size();
+	delete save.compressor;
+	save.compressor = nullptr;
+	save.output = nullptr;
+
+	save.ready = true;
+	return true;
+}
+
+void DefaultSaveFileManager::compressBackgroundSaves(uint32 maxBytes) {
+	// Only work on data in memory here, this is called from the timer
+	// thread, which is shared with audio and MIDI timers.
+	Common::StackLock lock(_backgroundSaveMutex);
+
+	for (Common::List<BackgroundSave *>::iterator save = _backgroundSaves.begin(), end = _backgroundSaves.end(); save != end; ++save) {
+		if ((*save)->ready)
+			continue;
+
+		// Leave the next one for the next tick.
+		if (!compressBackgroundSave(**save, maxBytes) || maxBytes)
+			return;
+	}
+}
+
+Common::Error DefaultSaveFileManager::writeBackgroundSave(BackgroundSave &save) {
+	if (save.failed)
+		return Common::Error(Common::kWritingFailed, "Failed to compress savefile '" + save.name + "'");
+
+	Common::WriteStream *sf = save.tempNode.createWriteStream();
+	if (!sf)
+		return Common::Error(Common::kWritingFailed, "Failed to create savefile '" + save.tempNode.getName() + "'");
+
+	Common::Error error(Common::kNoError);
+	if (sf->write(save.data, save.size) != save.size) {
+		error = Common::Error(Common::kWritingFailed, "Failed to write savefile '" + save.name + "'");
+	} else {
+		sf->finalize();
+		if (sf->err())
+			error = Common::Error(Common::kWritingFailed, "Failed to write savefile '" + save.name + "'");
+	}
+	delete sf;
+
+	if (error.getCode() == Common::kNoError) {
+		Common::ErrorCode result = renameFile(save.tempNode, save.fileNode);
+		if (result != Common::kNoError)
+			error = Common::Error(result, "Failed to replace savefile '" + save.name + "'");
+	}
+
+	if (error.getCode() != Common::kNoError)
+		removeFile(save.tempNode);
+
+	return error;
+}
+
+void DefaultSaveFileManager::handleBackgroundSaves() {
+	bool written = false;
+
+	for (;;) {
+		// Saves are written in order, a later save of the same file must
+		// not be overwritten by an earlier one.
+		_backgroundSaveMutex.lock();
+		BackgroundSave *save = nullptr;
+		if (!_backgroundSaves.empty() && _backgroundSaves.front()->ready) {
+			save = _backgroundSaves.front();
+			_backgroundSaves.pop_front();
+		}
+		_backgroundSaveMutex.unlock();
+
+		if (!save)
+			break;
+
+		Common::Error error = writeBackgroundSave(*save);
+		if (error.getCode() != Common::kNoError) {
+			warning("DefaultSaveFileManager: %s", error.getDesc().c_str());
+			_backgroundSaveFailed = true;
+		}
+		delete save;
+		written = true;
+	}
+
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	// This is what OutSaveFile::finalize() does for regular saves.
+	if (written)
+		CloudMan.syncSaves();
+#endif
+}
+
+void DefaultSaveFileManager::flushBackgroundSaves() {
+	compressBackgroundSaves(0);
+	handleBackgroundSaves();
+}
+
+void DefaultSaveFileManager::backgroundSaveTimer(void *refCon) {
+	static_cast<DefaultSaveFileManager *>(refCon)->compressBackgroundSaves(kBackgroundSaveChunkSize);
+}
+
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	// The file may not have been written yet.
+	flushBackgroundSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -198,6 +465,7 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 		// Remove from cache, this invalidates the 'file' iterator.
 		_saveFileCache.erase(file);
 		file = _saveFileCache.end();
+		_saveFileRevisions.erase(filename);
 
 		Common::ErrorCode result = removeFile(fileNode);
 		if (result == Common::kNoError)
@@ -219,6 +487,23 @@ Common::ErrorCode DefaultSaveFileManager::removeFile(const Common::FSNode &fileN
 	return Common::kUnknownError;
 }
 
+Common::ErrorCode DefaultSaveFileManager::renameFile(const Common::FSNode &oldNode, const Common::FSNode &newNode) {
+	Common::String oldPath(oldNode.getPath().toString(Common::Path::kNativeSeparator));
+	Common::String newPath(newNode.getPath().toString(Common::Path::kNativeSeparator));
+	if (rename(oldPath.c_str(), newPath.c_str()) == 0)
+		return Common::kNoError;
+
+	// Not every platform replaces an existing file when renaming.
+	if (newNode.exists() && removeFile(newNode) == Common::kNoError && rename(oldPath.c_str(), newPath.c_str()) == 0)
+		return Common::kNoError;
+
+	if (errno == EACCES)
+		return Common::kWritePermissionDenied;
+	if (errno == ENOENT)
+		return Common::kPathDoesNotExist;
+	return Common::kUnknownError;
+}
+
 bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
@@ -233,6 +518,26 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+bool DefaultSaveFileManager::getSavefileRevision(const Common::String &filename, uint32 &revision) {
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return false;
+
+	if (!_saveFileCache.contains(filename))
+		return false;
+
+	SaveFileRevisions::const_iterator i = _saveFileRevisions.find(filename);
+	if (i != _saveFileRevisions.end()) {
+		revision = i->_value;
+	} else {
+		revision = _nextSaveFileRevision++;
+		_saveFileRevisions[filename] = revision;
+	}
+
+	return true;
+}
+
 Common::Path DefaultSaveFileManager::getSavePath() const {
 
 	Common::Path dir;
@@ -266,6 +571,7 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 	}
 
 	_saveFileCache.clear();
+	_saveFileRevisions.clear();
 	_cachedDirectory.clear();
 
 	if (getError().getCode() != Common::kNoError) {
@@ -284,13 +590,24 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 
 	// Build the savefile name cache.
 	for (Common::FSList::const_iterator file = children.begin(), end = children.end(); file != end; ++file) {
-		if (_saveFileCache.contains(file->getName())) {
+		if (file->getName().hasSuffixIgnoreCase(BACKGROUND_SAVE_SUFFIX)) {
+			// Incomplete background save, see queueBackgroundSave().
+			continue;
+		} else if (_saveFileCache.contains(file->getName())) {
 			warning("DefaultSaveFileManager::assureCached: Name clash when building cache, ignoring file '%s'", file->getName().c_str());
 		} else {
 			_saveFileCache[file->getName()] = *file;
 		}
 	}
 
+	// Saves still being written in the background may not exist yet.
+	_backgroundSaveMutex.lock();
+	for (Common::List<BackgroundSave *>::const_iterator save = _backgroundSaves.begin(), end = _backgroundSaves.end(); save != end; ++save) {
+		if ((*save)->savePath == savePathName)
+			_saveFileCache[(*save)->name] = Common::FSNode((*save)->fileNode.getPath());
+	}
+	_backgroundSaveMutex.unlock();
+
 	// Only now store that we cached 'savePathName' to indicate we successfully
 	// cached the directory.
 	_cachedDirectory = savePathName;
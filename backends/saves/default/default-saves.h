@@ -27,6 +27,8 @@
 #include "common/str.h"
 #include "common/fs.h"
 #include "common/hash-str.h"
+#include "common/list.h"
+#include "common/mutex.h"
 
 /**
  * Provides a default savefile manager implementation for common platforms.
@@ -35,14 +37,18 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::Path &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
 	Common::InSaveFile *openRawFile(const Common::String &filename) override;
 	Common::InSaveFile *openForLoading(const Common::String &filename) override;
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
+	Common::OutSaveFile *openForSavingInBackground(const Common::String &filename, bool compress = true) override;
+	void handleBackgroundSaves() override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	bool getSavefileRevision(const Common::String &filename, uint32 &revision) override;
 
 #ifdef USE_LIBCURL
 
@@ -75,6 +81,18 @@ protected:
 	 */
 	virtual Common::ErrorCode removeFile(const Common::FSNode &fileNode);
 
+	/**
+	 * Renames the given file, replacing the destination if it exists.
+	 * This is called when a save file written in the background is complete.
+	 */
+	virtual Common::ErrorCode renameFile(const Common::FSNode &oldNode, const Common::FSNode &newNode);
+
+	/**
+	 * Compresses and writes all save files still pending from
+	 * openForSavingInBackground() right away, so that they can be accessed.
+	 */
+	void flushBackgroundSaves();
+
 	/**
 	 * Assure that the given save path is cached.
 	 *
@@ -93,6 +111,17 @@ protected:
 	 */
 	SaveFileCache _saveFileCache;
 
+	typedef Common::HashMap<Common::String, uint32, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveFileRevisions;
+
+	/**
+	 * Revisions handed out by getSavefileRevision(). A file gets a new one
+	 * when it is opened for saving or removed, and all of them are dropped
+	 * when the directory is cached again since it may have changed behind
+	 * our back.
+	 */
+	SaveFileRevisions _saveFileRevisions;
+	uint32 _nextSaveFileRevision;
+
 	/**
 	 * List of "locked" files. These cannot be used for saving/loading
 	 * because CloudManager is downloading those.
@@ -100,10 +129,42 @@ protected:
 	Common::StringArray _lockedFiles;
 
 private:
+	friend class BackgroundOutSaveFile;
+	struct BackgroundSave;
+
+	enum {
+		kBackgroundSaveInterval = 10000,    ///< Interval of the timer compressing background saves, in microseconds
+		kBackgroundSaveChunkSize = 64 * 1024 ///< Bytes compressed per timer tick
+	};
+
+	/**
+	 * Does the common checks before saving a file, and gets the node to
+	 * save it to.
+	 *
+	 * @return False if the file cannot be saved.
+	 */
+	bool prepareSaving(const Common::String &filename, Common::FSNode &fileNode);
+
+	void queueBackgroundSave(const Common::String &filename, byte *data, uint32 size, bool compress);
+	bool compressBackgroundSave(BackgroundSave &save, uint32 maxBytes);
+	void compressBackgroundSaves(uint32 maxBytes);
+	Common::Error writeBackgroundSave(BackgroundSave &save);
+	static void backgroundSaveTimer(void *refCon);
+
 	/**
 	 * The currently cached directory.
 	 */
 	Common::Path _cachedDirectory;
+
+	/**
+	 * Save files queued by openForSavingInBackground(), in the order they
+	 * are written. The timer thread only compresses them in memory, all
+	 * file access happens on the main thread. Shared with the timer thread,
+	 * so only access it while holding _backgroundSaveMutex.
+	 */
+	Common::List<BackgroundSave *> _backgroundSaves;
+	Common::Mutex _backgroundSaveMutex;
+	bool _backgroundSaveTimerInstalled;
 };
 
 #endif
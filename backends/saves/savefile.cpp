@@ -79,6 +79,44 @@ int64 OutSaveFile::size() const {
 	}
 }
 
+namespace {
+
+/**
+ * Records a failure to write a save file, which was opened for saving in
+ * the background but written synchronously, once it gets finalized.
+ */
+class CheckedOutSaveFile : public OutSaveFile {
+public:
+	CheckedOutSaveFile(OutSaveFile *file, bool &failed) : OutSaveFile(file), _failed(failed) {}
+
+	void finalize() override {
+		// The wrapped save file takes care of syncing the saves.
+		_wrapped->finalize();
+
+		if (err())
+			_failed = true;
+	}
+
+private:
+	bool &_failed;
+};
+
+} // End of anonymous namespace
+
+OutSaveFile *SaveFileManager::openForSavingInBackground(const String &name, bool compress) {
+	OutSaveFile *file = openForSaving(name, compress);
+	if (!file)
+		return nullptr;
+
+	return new CheckedOutSaveFile(file, _backgroundSaveFailed);
+}
+
+bool SaveFileManager::popBackgroundSaveFailed() {
+	const bool failed = _backgroundSaveFailed;
+	_backgroundSaveFailed = false;
+	return failed;
+}
+
 bool SaveFileManager::copySavefile(const String &oldFilename, const String &newFilename, bool compress) {
 	InSaveFile *inFile = nullptr;
 	OutSaveFile *outFile = nullptr;
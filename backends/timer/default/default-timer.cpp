@@ -23,6 +23,7 @@
 #include "backends/timer/default/default-timer.h"
 #include "common/util.h"
 #include "common/system.h"
+#include "common/tracing.h"
 
 struct TimerSlot {
 	Common::TimerManager::TimerProc callback;
@@ -80,6 +81,8 @@ DefaultTimerManager::~DefaultTimerManager() {
 }
 
 void DefaultTimerManager::handler() {
+	TRACE_ZONE("DefaultTimerManager::handler");
+
 	Common::StackLock lock(_mutex);
 
 	uint32 curTime = g_system->getMillis(true);
@@ -201,6 +201,12 @@ static const char HELP_STRING4[] =
 	"  --screenshot-period=NUM  When recording, trigger a screenshot every NUM milliseconds\n"
 	"                           (default: 60000)\n"
 	"  --list-records           Display a list of recordings for the target specified\n"
+	"  --benchmark=FILE         Play back the recording FILE as fast as possible and\n"
+	"                           print a timing report when it ends\n"
+#endif
+#ifdef ENABLE_TRACING
+	"  --trace=FILE             Record timing zones while the game runs and write\n"
+	"                           them to FILE in the Chrome trace format\n"
 #endif
 	"\n"
 #if defined(ENABLE_SKY) || defined(ENABLE_QUEEN)
@@ -318,6 +324,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_midi", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("synth_render_ahead", 0);
 
 	ConfMan.registerDefault("music_driver", "auto");
 	ConfMan.registerDefault("mt32_device", "null");
@@ -792,6 +799,14 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 
 			DO_LONG_OPTION_INT("screenshot-period")
 			END_OPTION
+
+			DO_LONG_OPTION("benchmark")
+			END_OPTION
+#endif
+
+#ifdef ENABLE_TRACING
+			DO_LONG_OPTION("trace")
+			END_OPTION
 #endif
 
 			DO_LONG_OPTION("opl-driver")
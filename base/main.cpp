@@ -49,6 +49,7 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
+#include "common/tracing.h"
 #include "common/translation.h"
 #include "common/text-to-speech.h"
 #include "common/osd_message_queue.h"
@@ -772,7 +773,9 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			Common::String recordMode = ConfMan.get("record_mode");
 			Common::String recordFileName = ConfMan.get("record_file_name");
 
-			if (recordMode == "record") {
+			if (ConfMan.hasKey("benchmark")) {
+				g_eventRec.init(ConfMan.get("benchmark"), GUI::EventRecorder::kRecorderPlayback, true);
+			} else if (recordMode == "record") {
 				Common::String targetFileName = ConfMan.hasKey("record_file_name") ? recordFileName : g_eventRec.generateRecordFileName(ConfMan.getActiveDomainName());
 				g_eventRec.init(targetFileName, GUI::EventRecorder::kRecorderRecord);
 			} else if (recordMode == "update") {
@@ -792,8 +795,19 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			if (ttsMan != nullptr) {
 				ttsMan->pushState();
 			}
+#ifdef ENABLE_TRACING
+			if (ConfMan.hasKey("trace"))
+				Common::startTracing();
+#endif
 			// Try to run the game
 			result = runGame(enginePlugin, system, game, meDescriptor);
+#ifdef ENABLE_TRACING
+			if (ConfMan.hasKey("trace")) {
+				Common::stopTracing();
+				if (!Common::writeTrace(Common::Path(ConfMan.get("trace"), Common::Path::kNativeSeparator)))
+					warning("Could not write trace to '%s'", ConfMan.get("trace").c_str());
+			}
+#endif
 			if (ttsMan != nullptr) {
 				ttsMan->popState();
 			}
@@ -25,6 +25,7 @@
 #include "common/fs.h"
 #include "common/textconsole.h"
 #include "common/system.h"
+#include "common/tracing.h"
 #include "backends/fs/fs-factory.h"
 
 namespace Common {
@@ -42,6 +43,8 @@ bool File::open(const Path &filename) {
 }
 
 bool File::open(const Path &filename, Archive &archive) {
+	TRACE_ZONE("File::open");
+
 	assert(!filename.empty());
 	assert(!_handle);
 
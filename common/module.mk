@@ -58,5 +58,10 @@ MODULE_OBJS += \
 	updates.o
 endif
 
+ifdef ENABLE_TRACING
+MODULE_OBJS += \
+	tracing.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
@@ -140,10 +140,10 @@ public:
  * SaveFileManager instances to be used.
  */
 class SaveFileManager : NonCopyable {
-
 protected:
 	Error _error;      /*!< Error code. */
 	String _errorDesc; /*!< Description of an error. */
+	bool _backgroundSaveFailed; /*!< Whether writing a background save failed, see popBackgroundSaveFailed(). */
 
 	/**
 	 * Set some information about the last error that occurred.
@@ -153,6 +153,7 @@ protected:
 	virtual void setError(Error error, const String &errorDesc) { _error = error; _errorDesc = errorDesc; }
 
 public:
+	SaveFileManager() : _backgroundSaveFailed(false) {}
 	virtual ~SaveFileManager() {}
 
 	/**
@@ -201,6 +202,44 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Open the save file with the specified @p name for saving without
+	 * blocking the caller on compression.
+	 *
+	 * Everything written to the returned stream is kept in memory. Once the
+	 * stream is finalized, the data is compressed in the background, and
+	 * written to disk by handleBackgroundSaves() on the main thread. It only
+	 * replaces a previous save file of the same name once it has been
+	 * written completely. Callers must finalize the stream, deleting it
+	 * without doing so may discard the data.
+	 *
+	 * Since the data is buffered, err() only reports problems with the
+	 * buffer. Whether writing to disk failed is reported by
+	 * popBackgroundSaveFailed().
+	 *
+	 * The default implementation writes synchronously using openForSaving().
+	 *
+	 * @param name      Name of the save file.
+	 * @param compress  Whether to compress the resulting save file (default) or not.
+	 *
+	 * @return Pointer to an OutSaveFile, or NULL if an error occurred.
+	 */
+	virtual OutSaveFile *openForSavingInBackground(const String &name, bool compress = true);
+
+	/**
+	 * Write the save files opened with openForSavingInBackground() which
+	 * are ready to disk. This is called regularly by the event manager, and
+	 * must only be called from the main thread.
+	 */
+	virtual void handleBackgroundSaves() {}
+
+	/**
+	 * Return whether writing a save file opened with
+	 * openForSavingInBackground() failed since the last call.
+	 * Also, clear that state.
+	 */
+	bool popBackgroundSaveFailed();
+
 	/**
 	 * Open the file with the specified @p name in the given directory for loading.
 	 *
@@ -276,6 +315,20 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Get a number which changes whenever the savefile might have been
+	 * modified. This lets callers cache information read from the file,
+	 * for as long as the revision stays the same.
+	 *
+	 * @param name     Name of the save file.
+	 * @param revision Set to the current revision of the file.
+	 *
+	 * @return true if a revision is available. false if the file does not
+	 *         exist or changes are not tracked, in which case nothing read
+	 *         from the file should be cached.
+	 */
+	virtual bool getSavefileRevision(const String &name, uint32 &revision) { return false; }
 };
 
 /** @} */
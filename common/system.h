@@ -1510,6 +1510,15 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get the number of microseconds since an arbitrary point in time,
+	 * for measuring short durations, like in profiling code.
+	 *
+	 * The value is never recorded by the event recorder. The default
+	 * implementation only has the precision of getMillis().
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1595,6 +1604,15 @@ public:
 	 */
 	virtual Common::MutexInternal *createMutex() = 0;
 
+	/**
+	 * Return an identifier of the calling thread, which differs between
+	 * the threads running at the same time. This is meant for debugging
+	 * code, like the tracing zones.
+	 *
+	 * @return The identifier, or 0 if the backend cannot tell threads apart.
+	 */
+	virtual uint64 getThreadId() { return 0; }
+
 	/** @} */
 
 
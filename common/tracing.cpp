@@ -0,0 +1,255 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/tracing.h"
+
+#ifdef ENABLE_TRACING
+
+#include "common/array.h"
+#include "common/file.h"
+#include "common/mutex.h"
+#include "common/str.h"
+#include "common/system.h"
+
+namespace Common {
+
+namespace {
+
+enum {
+	kTraceBufferSize = 65536,
+	kMaxTraceThreads = 16
+};
+
+struct TraceEvent {
+	const char *name;
+	uint64 start;
+	uint64 duration; // The value, for counters
+	bool counter;
+};
+
+/**
+ * The events of one thread. Only that thread writes to the buffer, and it
+ * only bumps count after writing the event, so the buffer can be read
+ * while the thread keeps recording.
+ */
+struct TraceBuffer {
+	uint64 threadId; // As returned by OSystem::getThreadId()
+	uint tid; // As written to the trace
+	volatile uint32 count; // Total number of recorded events, the buffer wraps around
+	volatile TraceEvent events[kTraceBufferSize];
+};
+
+volatile bool g_tracing = false;
+// Guards registering buffers, g_sharedTraceBuffer and g_traceStart
+Mutex *g_traceMutex = nullptr;
+TraceBuffer *volatile g_traceBuffers[kMaxTraceThreads];
+volatile uint g_numTraceBuffers = 0;
+// Used by threads the backend cannot tell apart, and once all the other buffers are taken
+TraceBuffer *g_sharedTraceBuffer = nullptr;
+uint g_traceThreads = 0;
+uint64 g_traceStart = 0;
+
+TraceBuffer *createTraceBuffer(uint64 threadId) {
+	TraceBuffer *buffer = new TraceBuffer();
+	buffer->threadId = threadId;
+	buffer->tid = ++g_traceThreads;
+	buffer->count = 0;
+	return buffer;
+}
+
+/**
+ * Return the buffer of the calling thread, or nullptr if the thread has
+ * to use the shared buffer.
+ */
+TraceBuffer *getThreadTraceBuffer() {
+	const uint64 threadId = g_system->getThreadId();
+	if (!threadId)
+		return nullptr;
+
+	// Buffers are never removed, and only published once set up
+	const uint numBuffers = g_numTraceBuffers;
+	for (uint i = 0; i < numBuffers; i++) {
+		if (g_traceBuffers[i]->threadId == threadId)
+			return g_traceBuffers[i];
+	}
+
+	StackLock lock(*g_traceMutex);
+
+	if (g_numTraceBuffers == kMaxTraceThreads)
+		return nullptr;
+
+	TraceBuffer *buffer = createTraceBuffer(threadId);
+	g_traceBuffers[g_numTraceBuffers] = buffer;
+	g_numTraceBuffers = g_numTraceBuffers + 1;
+	return buffer;
+}
+
+void writeEvent(TraceBuffer *buffer, const char *name, uint64 start, uint64 duration, bool counter) {
+	const uint32 count = buffer->count;
+	volatile TraceEvent &event = buffer->events[count % kTraceBufferSize];
+	event.name = name;
+	event.start = start;
+	event.duration = duration;
+	event.counter = counter;
+	buffer->count = count + 1;
+}
+
+void recordEvent(const char *name, uint64 start, uint64 duration, bool counter) {
+	TraceBuffer *buffer = getThreadTraceBuffer();
+	if (buffer) {
+		writeEvent(buffer, name, start, duration, counter);
+		return;
+	}
+
+	StackLock lock(*g_traceMutex);
+	if (!g_sharedTraceBuffer)
+		g_sharedTraceBuffer = createTraceBuffer(0);
+	writeEvent(g_sharedTraceBuffer, name, start, duration, counter);
+}
+
+/**
+ * Copy the events of a buffer, oldest first. Its thread may keep recording
+ * meanwhile, so the events it could have overwritten are dropped.
+ */
+void copyEvents(const TraceBuffer *buffer, Array<TraceEvent> &events) {
+	const uint32 end = buffer->count;
+	const uint32 begin = end - MIN<uint32>(end, kTraceBufferSize);
+
+	events.resize(end - begin);
+	for (uint32 i = begin; i < end; i++) {
+		const volatile TraceEvent &event = buffer->events[i % kTraceBufferSize];
+		events[i - begin].name = event.name;
+		events[i - begin].start = event.start;
+		events[i - begin].duration = event.duration;
+		events[i - begin].counter = event.counter;
+	}
+
+	// The slot of the event being written is the one of the oldest event
+	const uint32 newEnd = buffer->count;
+	if (newEnd - begin >= kTraceBufferSize) {
+		const uint32 overwritten = MIN<uint32>(newEnd - begin - kTraceBufferSize + 1, events.size());
+		for (uint32 i = overwritten; i < events.size(); i++)
+			events[i - overwritten] = events[i];
+		events.resize(events.size() - overwritten);
+	}
+}
+
+uint64 getTraceTime() {
+	return g_system->getMicros();
+}
+
+} // End of anonymous namespace
+
+void startTracing() {
+	if (!g_traceMutex)
+		g_traceMutex = new Mutex();
+
+	// The buffers are not cleared, zones recorded before this are skipped
+	// when writing the trace instead.
+	StackLock lock(*g_traceMutex);
+	g_traceStart = getTraceTime();
+	g_tracing = true;
+}
+
+void stopTracing() {
+	g_tracing = false;
+}
+
+bool isTracing() {
+	return g_tracing;
+}
+
+bool writeTrace(const Path &fileName) {
+	if (!g_traceMutex)
+		return false;
+
+	DumpFile file;
+	if (!file.open(fileName, true))
+		return false;
+
+	StackLock lock(*g_traceMutex);
+
+	Array<TraceBuffer *> buffers;
+	for (uint i = 0; i < g_numTraceBuffers; i++) {
+		TraceBuffer *buffer = g_traceBuffers[i];
+		buffers.push_back(buffer);
+	}
+	if (g_sharedTraceBuffer)
+		buffers.push_back(g_sharedTraceBuffer);
+
+	file.writeString("{\"traceEvents\":[\n");
+
+	bool first = true;
+	Array<TraceEvent> events;
+	for (uint i = 0; i < buffers.size(); i++) {
+		copyEvents(buffers[i], events);
+
+		for (uint32 j = 0; j < events.size(); j++) {
+			const TraceEvent &event = events[j];
+
+			// Zones which started before tracing was last started
+			if (event.start < g_traceStart)
+				continue;
+
+			// Timestamps are written relative to the start of tracing
+			const unsigned long long start = event.start - g_traceStart;
+			if (event.counter) {
+				file.writeString(String::format("%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"args\":{\"value\":%llu}}",
+				                                first ? "" : ",\n", event.name, buffers[i]->tid,
+				                                start, (unsigned long long)event.duration));
+			} else {
+				file.writeString(String::format("%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%llu}",
+				                                first ? "" : ",\n", event.name, buffers[i]->tid,
+				                                start, (unsigned long long)event.duration));
+			}
+			first = false;
+		}
+	}
+
+	file.writeString("\n],\"displayTimeUnit\":\"ms\"}\n");
+	file.finalize();
+
+	return !file.err();
+}
+
+TraceZone::TraceZone(const char *name) : _name(name), _start(0), _started(g_tracing) {
+	if (_started)
+		_start = getTraceTime();
+}
+
+TraceZone::~TraceZone() {
+	// Zones which started before tracing was enabled are dropped
+	if (!g_tracing || !_started)
+		return;
+
+	recordEvent(_name, _start, getTraceTime() - _start, false);
+}
+
+void traceCounter(const char *name, uint64 value) {
+	if (!g_tracing)
+		return;
+
+	recordEvent(name, getTraceTime(), value, true);
+}
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,110 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_TRACING_H
+#define COMMON_TRACING_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+class Path;
+
+/**
+ * @defgroup common_tracing Tracing
+ * @ingroup common
+ *
+ * @brief  Scoped timing zones exported as Chrome trace events.
+ *
+ * Zones are only compiled in when ScummVM is configured with
+ * --enable-tracing, otherwise TRACE_ZONE and TRACE_COUNTER expand
+ * to nothing.
+ *
+ * Each thread records its zones into its own ring buffer without
+ * locking, so the oldest zones are overwritten when tracing for a long
+ * time. Threads are told apart with OSystem::getThreadId(). Threads the
+ * backend cannot tell apart, and the threads started once 16 buffers are
+ * taken, share one buffer guarded by a mutex. Buffers are kept until
+ * ScummVM exits, as threads cannot be notified of their exit portably.
+ * The recorded zones can be loaded in chrome://tracing or Perfetto.
+ * @{
+ */
+
+#ifdef ENABLE_TRACING
+
+/** Start recording zones, discarding the ones recorded so far. */
+void startTracing();
+
+/** Stop recording zones. */
+void stopTracing();
+
+/** Return whether zones are currently being recorded. */
+bool isTracing();
+
+/**
+ * Write the recorded zones to a file in the Chrome trace event format.
+ *
+ * @return False if the file could not be written.
+ */
+bool writeTrace(const Path &fileName);
+
+/**
+ * Record the value of a counter, shown as a graph next to the zones.
+ *
+ * The name must stay valid until the trace is written,
+ * string literals are expected.
+ */
+void traceCounter(const char *name, uint64 value);
+
+/**
+ * Record the time spent in the enclosing scope.
+ *
+ * The name must stay valid until the trace is written,
+ * string literals are expected.
+ */
+class TraceZone {
+public:
+	explicit TraceZone(const char *name);
+	~TraceZone();
+
+private:
+	const char *_name;
+	uint64 _start;
+	bool _started;
+};
+
+#define TRACE_ZONE_NAME2(line) traceZone ## line
+#define TRACE_ZONE_NAME(line) TRACE_ZONE_NAME2(line)
+#define TRACE_ZONE(name) Common::TraceZone TRACE_ZONE_NAME(__LINE__)(name)
+#define TRACE_COUNTER(name, value) Common::traceCounter(name, value)
+
+#else
+
+#define TRACE_ZONE(name) do {} while (false)
+#define TRACE_COUNTER(name, value) do {} while (false)
+
+#endif
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -596,6 +596,12 @@ void Engine::handleAutoSave() {
 	if (!g_eventRec.processAutosave())
 		return;
 #endif
+	if (_saveFileMan->popBackgroundSaveFailed()) {
+		// Same as when saveGameState() fails, try again in 5 minutes
+		g_system->displayMessageOnOSD(_("Error occurred making autosave"));
+		_lastAutosaveTime = _system->getMillis() + ((5 * 60 - _autosaveInterval) * 1000);
+	}
+
 	const int diff = _system->getMillis() - _lastAutosaveTime;
 
 	if (_autosaveInterval != 0 && diff > (_autosaveInterval * 1000)) {
@@ -897,7 +903,12 @@ bool Engine::canLoadGameStateCurrently(Common::U32String *msg) {
 }
 
 Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool isAutosave) {
-	Common::OutSaveFile *saveFile = _saveFileMan->openForSaving(getSaveStateName(slot));
+	// Autosaves happen during gameplay, so do not stall the game writing them.
+	Common::OutSaveFile *saveFile;
+	if (isAutosave)
+		saveFile = _saveFileMan->openForSavingInBackground(getSaveStateName(slot));
+	else
+		saveFile = _saveFileMan->openForSaving(getSaveStateName(slot));
 
 	if (!saveFile)
 		return Common::kWritingFailed;
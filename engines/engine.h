@@ -460,6 +460,10 @@ public:
 	 * @param desc        Description for the save state, entered by the user.
 	 * @param isAutosave  Expected to be true if an autosave is being created.
 	 *
+	 * The default implementation writes autosaves in the background. For
+	 * those, kNoError only means that the save was created, failing to
+	 * write it is reported by handleAutoSave() later on.
+	 *
 	 * @return kNoError on success, otherwise an error code.
 	 */
 	virtual Common::Error saveGameState(int slot, const Common::String &desc, bool isAutosave = false);
@@ -20,6 +20,9 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/debug.h"
 
 namespace Glk {
 namespace Glulx {
@@ -33,6 +36,9 @@ void Glulx::enter_function(uint funcaddr, uint argc, uint *argv) {
 	int loctype, locnum;
 	uint addr = funcaddr;
 
+	if (profile_call_counts)
+		profile_calls[funcaddr]++;
+
 	accelFunc = accel_get_func(addr);
 	if (accelFunc) {
 		profile_in(addr, stackptr, true);
@@ -294,5 +300,34 @@ uint Glulx::pop_callstub_string(int *bitnum) {
 	return 0;
 }
 
+void Glulx::profile_set_call_counts(int flag) {
+	profile_call_counts = (flag != 0);
+	if (!profile_call_counts)
+		profile_calls.clear();
+}
+
+void Glulx::profile_report_call_counts() {
+	struct CallCount {
+		uint addr;
+		uint count;
+	};
+	Common::Array<CallCount> counts;
+
+	if (!profile_call_counts || profile_calls.empty())
+		return;
+
+	for (Common::HashMap<uint, uint>::const_iterator it = profile_calls.begin(); it != profile_calls.end(); ++it)
+		counts.push_back({ it->_key, it->_value });
+	Common::sort(counts.begin(), counts.end(), [](const CallCount &a, const CallCount &b) {
+		return a.count > b.count;
+	});
+
+	debugC(kDebugScripts, "Glulx function call counts (%u functions):", counts.size());
+	for (uint ix = 0; ix < counts.size() && ix < 32; ix++) {
+		debugC(kDebugScripts, "  %08x: %u calls%s", counts[ix].addr, counts[ix].count,
+			accel_get_func(counts[ix].addr) ? " (accelerated)" : "");
+	}
+}
+
 } // End of namespace Glulx
 } // End of namespace Glk
@@ -36,6 +36,10 @@ Glulx::Glulx(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst, g
 		stream_char_handler(nullptr), stream_unichar_handler(nullptr),
 		// main
 		library_autorestore_hook(nullptr),
+		// operand
+		decode_cache(nullptr),
+		// profile
+		profile_call_counts(false),
 		// accel
 		classes_table(0), indiv_prop_start(0), class_metaclass(0), object_metaclass(0),
 		routine_metaclass(0), string_metaclass(0), self(0), num_attr_bytes(0), cpv__start(0),
@@ -43,7 +47,8 @@ Glulx::Glulx(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst, g
 		// heap
 		heap_start(0), alloc_count(0), heap_head(nullptr), heap_tail(nullptr),
 		// serial
-		max_undo_level(8), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr), ramcache(nullptr),
+		max_undo_level(32), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr), undo_dirty(nullptr),
+		undo_shadow(nullptr), undo_pagecount(0), ramcache(nullptr),
 		// string
 		iosys_mode(0), iosys_rock(0), tablecache_valid(false), glkio_unichar_han_ptr(nullptr) {
 	g_vm = this;
@@ -25,6 +25,7 @@
 #define GLK_GLULXE
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 #include "common/random.h"
 #include "glk/glk_api.h"
 #include "glk/glulx/glulx_types.h"
@@ -145,6 +146,16 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Decoded instructions from ROM, indexed by a hash of their address.
+	 */
+	decodedinst_t *decode_cache;
+
+	/**
+	 * Holds the current instruction when it can't come from decode_cache.
+	 */
+	decodedinst_t decode_scratch;
+
 	/**@}*/
 
 	/**
@@ -161,6 +172,15 @@ private:
 	int undo_chain_num;
 	byte **undo_chain;
 
+	/**
+	 * Undo snapshots are differential. undo_dirty flags each UNDO_PAGE_SIZE page of main memory
+	 * written since the last snapshot, and undo_shadow holds memory as it stood at that snapshot.
+	 * Each undo_chain entry then only stores the pages needed to step back to the one before it.
+	 */
+	byte *undo_dirty;
+	byte *undo_shadow;
+	uint undo_pagecount;
+
 	/**
 	 * This will contain a copy of RAM (ramstate to endmem) as it exists in the game file.
 	 */
@@ -543,13 +563,22 @@ public:
 	const operandlist_t *lookup_operandlist(uint opcode);
 
 	/**
-	 * Read the list of operands of an instruction, and put the values in args. This assumes
-	 * that the PC is at the beginning of the operand mode list (right after an opcode number.)
-	 * Upon return, the PC will be at the beginning of the next instruction.
-	 *
-	 * This also assumes that args points at an allocated array of MAX_OPERANDS oparg_t structures.
-	*/
-	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
+	 * Return the decoded form of the instruction at addr, decoding it if it isn't already
+	 * cached. The result stays valid until the next call.
+	 */
+	const decodedinst_t *decode_instruction(uint addr);
+
+	/**
+	 * Read the opcode number and operand modes of the instruction at addr into dinst.
+	 */
+	void decode_instruction_at(decodedinst_t *dinst, uint addr);
+
+	/**
+	 * Fetch the operand values of a decoded instruction into args, which must point at an
+	 * allocated array of MAX_OPERANDS oparg_t structures. This pops the stack and reads
+	 * memory and locals as the operand modes require.
+	 */
+	void load_operands(oparg_t *opargs, const decodedinst_t *dinst);
 
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
@@ -817,8 +846,21 @@ public:
 
 	void setup_profile(strid_t stream, char *filename);
 	int init_profile();
+
+	/**
+	 * When set, every function call is counted by address in profile_calls. The busiest
+	 * functions are candidates for acceleration; see profile_report_call_counts().
+	 */
+	bool profile_call_counts;
+	Common::HashMap<uint, uint> profile_calls;
+
 	void profile_set_call_counts(int flag);
 
+	/**
+	 * Log the most frequently called functions to the scripts debug channel.
+	 */
+	void profile_report_call_counts();
+
 #ifdef VM_PROFILING
 	uint profile_opcount;
 	#define profile_tick() (profile_opcount++)
@@ -953,6 +995,23 @@ public:
 	 */
 	uint perform_restoreundo();
 
+	/**
+	 * Grow the undo page tracking to cover at least newlen bytes of main memory.
+	 * This returns 0 on success, 1 on failure.
+	 */
+	uint undo_resize(uint newlen);
+
+	/**
+	 * Flag every undo page overlapping the given range of main memory as dirty. This must be called
+	 * by anything that writes to memmap directly rather than through the MemW macros.
+	 */
+	void undo_mark_dirty(uint addr, uint len);
+
+	/**
+	 * Drop every undo snapshot, e.g. when the page tracking can no longer be trusted.
+	 */
+	void undo_discard();
+
 	uint perform_verify();
 
 	/**@}*/
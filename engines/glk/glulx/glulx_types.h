@@ -88,12 +88,22 @@ class Glulx;
 #define VerifyW(adr, ln) (0)
 #endif /* VERIFY_MEMORY_ACCESS */
 
+/**
+ * Main memory is tracked in pages of this size for differential undo. Glulx memory sizes are
+ * always multiples of 256, so a page never straddles endmem.
+ */
+#define UNDO_PAGE_SHIFT (8)
+#define UNDO_PAGE_SIZE  (1 << UNDO_PAGE_SHIFT)
+
+#define MarkDirty(adr, ln) \
+	(undo_dirty[(adr) >> UNDO_PAGE_SHIFT] = 1, undo_dirty[((adr) + (ln) - 1) >> UNDO_PAGE_SHIFT] = 1)
+
 #define Mem1(adr)  (Read1(memmap+(adr)))
 #define Mem2(adr)  (Read2(memmap+(adr)))
 #define Mem4(adr)  (Read4(memmap+(adr)))
-#define MemW1(adr, vl)  (VerifyW(adr, 1), Write1(memmap+(adr), (vl)))
-#define MemW2(adr, vl)  (VerifyW(adr, 2), Write2(memmap+(adr), (vl)))
-#define MemW4(adr, vl)  (VerifyW(adr, 4), Write4(memmap+(adr), (vl)))
+#define MemW1(adr, vl)  (VerifyW(adr, 1), undo_dirty[(adr) >> UNDO_PAGE_SHIFT] = 1, Write1(memmap+(adr), (vl)))
+#define MemW2(adr, vl)  (VerifyW(adr, 2), MarkDirty(adr, 2), Write2(memmap+(adr), (vl)))
+#define MemW4(adr, vl)  (VerifyW(adr, 4), MarkDirty(adr, 4), Write4(memmap+(adr), (vl)))
 
 #ifndef _HUGE_ENUF
 #define _HUGE_ENUF  1e+300  // _HUGE_ENUF*_HUGE_ENUF must overflow
@@ -351,6 +361,46 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How a decoded operand gets its value when the instruction is executed.
+ */
+enum opkind {
+	opkind_Const = 0,       ///< Load operand with a constant value
+	opkind_Pop = 1,         ///< Load operand popped off the stack
+	opkind_Mem = 2,         ///< Load operand read from main memory at value
+	opkind_Local = 3,       ///< Load operand read from the locals segment at value
+	opkind_Store = 4        ///< Store operand; desttype and value are used as they are
+};
+
+/**
+ * Represents one operand of a decoded instruction: its addressing mode, and whatever constant
+ * or address followed it in the instruction stream.
+ */
+struct decodedop_struct {
+	uint kind;
+	uint desttype;
+	uint value;
+};
+typedef decodedop_struct decodedop_t;
+
+/**
+ * Represents an instruction whose opcode number and operand modes have already been parsed.
+ * Instructions in ROM are kept in a cache keyed by their address, so hot loops only pay for
+ * the operand values themselves. ROM can't be written, so the cache never needs flushing;
+ * instructions in RAM are decoded afresh every time they run.
+ */
+struct decodedinst_struct {
+	uint addr;              ///< Address of the instruction, or DECODE_CACHE_EMPTY
+	uint nextpc;            ///< Address of the following instruction
+	uint opcode;
+	const operandlist_t *oplist;
+	decodedop_t ops[MAX_OPERANDS];
+};
+typedef decodedinst_struct decodedinst_t;
+
+#define DECODE_CACHE_SIZE (4096)
+#define DECODE_CACHE_EMPTY (0xFFFFFFFF)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -66,6 +66,12 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	decode_cache = (decodedinst_t *)glulx_malloc(sizeof(decodedinst_t) * DECODE_CACHE_SIZE);
+	if (!decode_cache)
+		fatal_error("Unable to allocate instruction cache.");
+	for (int ix = 0; ix < DECODE_CACHE_SIZE; ix++)
+		decode_cache[ix].addr = DECODE_CACHE_EMPTY;
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -279,22 +285,79 @@ const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
 	}
 }
 
-void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
+const decodedinst_t *Glulx::decode_instruction(uint addr) {
+	decodedinst_t *dinst;
+
+	if (addr >= ramstart) {
+		/* Code in RAM may be rewritten at any time, so it's never cached. */
+		decode_instruction_at(&decode_scratch, addr);
+		return &decode_scratch;
+	}
+
+	dinst = &decode_cache[(addr ^ (addr >> 12)) & (DECODE_CACHE_SIZE - 1)];
+	if (dinst->addr == addr)
+		return dinst;
+
+	decode_instruction_at(dinst, addr);
+	/* An instruction that runs on past the end of ROM is fine to execute
+	   this once, but mustn't be found in the cache later. */
+	dinst->addr = (dinst->nextpc <= ramstart) ? addr : DECODE_CACHE_EMPTY;
+	return dinst;
+}
+
+void Glulx::decode_instruction_at(decodedinst_t *dinst, uint addr) {
 	int ix;
-	oparg_t *curarg;
-	int numops = oplist->num_ops;
-	int argsize = oplist->arg_size;
-	uint modeaddr = pc;
+	decodedop_t *curop;
+	const operandlist_t *oplist;
+	uint opcode;
+	uint pos = addr;
+	uint modeaddr;
 	int modeval = 0;
+	int numops;
+
+	/* Fetch the opcode number. */
+	opcode = Mem1(pos);
+	pos++;
+	if (opcode & 0x80) {
+		/* More than one-byte opcode. */
+		if (opcode & 0x40) {
+			/* Four-byte opcode */
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(pos);
+			pos++;
+			opcode = (opcode << 8) | Mem1(pos);
+			pos++;
+			opcode = (opcode << 8) | Mem1(pos);
+			pos++;
+		} else {
+			/* Two-byte opcode */
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(pos);
+			pos++;
+		}
+	}
 
-	pc += (numops + 1) / 2;
+	/* Fetch the structure that describes how the operands for this
+	   opcode are arranged. This is a pointer to an immutable,
+	   static object. */
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
 
-	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	numops = oplist->num_ops;
+	modeaddr = pos;
+	pos += (numops + 1) / 2;
+
+	for (ix = 0, curop = dinst->ops; ix < numops; ix++, curop++) {
 		int mode;
 		uint value;
-		uint addr;
+		uint addr2;
 
-		curarg->desttype = 0;
+		curop->desttype = 0;
 
 		if ((ix & 1) == 0) {
 			modeval = Mem1(modeaddr);
@@ -309,111 +372,91 @@ void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
 			switch (mode) {
 
 			case 8: /* pop off stack */
-				if (stackptr < valstackbase + 4) {
-					fatal_error("Stack underflow in operand.");
-				}
-				stackptr -= 4;
-				value = Stk4(stackptr);
+				curop->kind = opkind_Pop;
+				value = 0;
 				break;
 
 			case 0: /* constant zero */
+				curop->kind = opkind_Const;
 				value = 0;
 				break;
 
 			case 1: /* one-byte constant */
 				/* Sign-extend from 8 bits to 32 */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
+				curop->kind = opkind_Const;
+				value = (int)(signed char)(Mem1(pos));
+				pos++;
 				break;
 
 			case 2: /* two-byte constant */
 				/* Sign-extend the first byte from 8 bits to 32; the subsequent
 				   byte must not be sign-extended. */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				value = (value << 8) | (uint)(Mem1(pc));
-				pc++;
+				curop->kind = opkind_Const;
+				value = (int)(signed char)(Mem1(pos));
+				pos++;
+				value = (value << 8) | (uint)(Mem1(pos));
+				pos++;
 				break;
 
 			case 3: /* four-byte constant */
 				/* Bytes must not be sign-extended. */
-				value = Mem4(pc);
-				pc += 4;
+				curop->kind = opkind_Const;
+				value = Mem4(pos);
+				pos += 4;
 				break;
 
 			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto MainMemAddr;
+				curop->kind = opkind_Mem;
+				value = Mem4(pos) + ramstart;
+				pos += 4;
+				break;
 
 			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto MainMemAddr;
+				curop->kind = opkind_Mem;
+				value = (uint)Mem2(pos) + ramstart;
+				pos += 2;
+				break;
 
 			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto MainMemAddr;
+				curop->kind = opkind_Mem;
+				value = (uint)(Mem1(pos)) + ramstart;
+				pos++;
+				break;
 
 			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto MainMemAddr;
+				curop->kind = opkind_Mem;
+				value = Mem4(pos);
+				pos += 4;
+				break;
 
 			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto MainMemAddr;
+				curop->kind = opkind_Mem;
+				value = (uint)Mem2(pos);
+				pos += 2;
+				break;
 
 			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-MainMemAddr:
-				/* cases 5, 6, 7, 13, 14, 15 all wind up here. */
-				if (argsize == 4) {
-					value = Mem4(addr);
-				} else if (argsize == 2) {
-					value = Mem2(addr);
-				} else {
-					value = Mem1(addr);
-				}
+				curop->kind = opkind_Mem;
+				value = (uint)(Mem1(pos));
+				pos++;
 				break;
 
 			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto LocalsAddr;
+				curop->kind = opkind_Local;
+				value = Mem4(pos);
+				pos += 4;
+				break;
 
 			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto LocalsAddr;
+				curop->kind = opkind_Local;
+				value = (uint)Mem2(pos);
+				pos += 2;
+				break;
 
 			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-LocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				addr += localsbase;
-				if (argsize == 4) {
-					value = Stk4(addr);
-				} else if (argsize == 2) {
-					value = Stk2(addr);
-				} else {
-					value = Stk1(addr);
-				}
+				curop->kind = opkind_Local;
+				value = (uint)(Mem1(pos));
+				pos++;
 				break;
 
 			default:
@@ -421,73 +464,75 @@ LocalsAddr:
 				fatal_error("Unknown addressing mode in load operand.");
 			}
 
-			curarg->value = value;
+			curop->value = value;
 
 		} else { /* modeform_Store */
+			curop->kind = opkind_Store;
+
 			switch (mode) {
 
 			case 0: /* discard value */
-				curarg->desttype = 0;
-				curarg->value = 0;
+				curop->desttype = 0;
+				curop->value = 0;
 				break;
 
 			case 8: /* push on stack */
-				curarg->desttype = 3;
-				curarg->value = 0;
+				curop->desttype = 3;
+				curop->value = 0;
 				break;
 
 			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
+				addr2 = Mem4(pos);
+				addr2 += ramstart;
+				pos += 4;
 				goto WrMainMemAddr;
 
 			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
+				addr2 = (uint)Mem2(pos);
+				addr2 += ramstart;
+				pos += 2;
 				goto WrMainMemAddr;
 
 			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
+				addr2 = (uint)(Mem1(pos));
+				addr2 += ramstart;
+				pos++;
 				goto WrMainMemAddr;
 
 			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
+				addr2 = Mem4(pos);
+				pos += 4;
 				goto WrMainMemAddr;
 
 			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
+				addr2 = (uint)Mem2(pos);
+				pos += 2;
 				goto WrMainMemAddr;
 
 			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
+				addr2 = (uint)(Mem1(pos));
+				pos++;
 				/* fall through */
 
 WrMainMemAddr:
 				/* cases 5, 6, 7 all wind up here. */
-				curarg->desttype = 1;
-				curarg->value = addr;
+				curop->desttype = 1;
+				curop->value = addr2;
 				break;
 
 			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
+				addr2 = Mem4(pos);
+				pos += 4;
 				goto WrLocalsAddr;
 
 			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
+				addr2 = (uint)Mem2(pos);
+				pos += 2;
 				goto WrLocalsAddr;
 
 			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
+				addr2 = (uint)(Mem1(pos));
+				pos++;
 				/* fall through */
 
 WrLocalsAddr:
@@ -496,11 +541,11 @@ WrLocalsAddr:
 				   A "strict mode" interpreter probably should. It's also illegal
 				   for addr to be less than zero or greater than the size of
 				   the locals segment. */
-				curarg->desttype = 2;
+				curop->desttype = 2;
 				/* We don't add localsbase here; the store address for desttype 2
 				   is relative to the current locals segment, not an absolute
 				   stack position. */
-				curarg->value = addr;
+				curop->value = addr2;
 				break;
 
 			case 1:
@@ -514,6 +559,71 @@ WrLocalsAddr:
 			}
 		}
 	}
+
+	dinst->opcode = opcode;
+	dinst->oplist = oplist;
+	dinst->nextpc = pos;
+}
+
+void Glulx::load_operands(oparg_t *args, const decodedinst_t *dinst) {
+	int ix;
+	oparg_t *curarg;
+	const decodedop_t *curop;
+	int numops = dinst->oplist->num_ops;
+	int argsize = dinst->oplist->arg_size;
+	uint addr;
+
+	for (ix = 0, curarg = args, curop = dinst->ops; ix < numops; ix++, curarg++, curop++) {
+		switch (curop->kind) {
+
+		case opkind_Const:
+			curarg->desttype = 0;
+			curarg->value = curop->value;
+			break;
+
+		case opkind_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			curarg->desttype = 0;
+			curarg->value = Stk4(stackptr);
+			break;
+
+		case opkind_Mem:
+			addr = curop->value;
+			curarg->desttype = 0;
+			if (argsize == 4) {
+				curarg->value = Mem4(addr);
+			} else if (argsize == 2) {
+				curarg->value = Mem2(addr);
+			} else {
+				curarg->value = Mem1(addr);
+			}
+			break;
+
+		case opkind_Local:
+			/* It's illegal for addr to not be four-byte aligned, but we don't
+			   check this explicitly. A "strict mode" interpreter probably should.
+			   It's also illegal for addr to be less than zero or greater than
+			   the size of the locals segment. */
+			addr = curop->value + localsbase;
+			curarg->desttype = 0;
+			if (argsize == 4) {
+				curarg->value = Stk4(addr);
+			} else if (argsize == 2) {
+				curarg->value = Stk2(addr);
+			} else {
+				curarg->value = Stk1(addr);
+			}
+			break;
+
+		default: /* opkind_Store */
+			curarg->desttype = curop->desttype;
+			curarg->value = curop->value;
+			break;
+		}
+	}
 }
 
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
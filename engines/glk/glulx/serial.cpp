@@ -33,6 +33,9 @@ bool Glulx::init_serial() {
 	if (!undo_chain)
 		return false;
 
+	if (undo_resize(endmem))
+		return false;
+
 #ifdef SERIALIZE_CACHE_RAM
 	{
 		uint len = (endmem - ramstart);
@@ -53,16 +56,23 @@ bool Glulx::init_serial() {
 
 void Glulx::final_serial() {
 	if (undo_chain) {
-		int ix;
-		for (ix = 0; ix < undo_chain_num; ix++) {
-			glulx_free(undo_chain[ix]);
-		}
+		undo_discard();
 		glulx_free(undo_chain);
 	}
 	undo_chain = nullptr;
 	undo_chain_size = 0;
 	undo_chain_num = 0;
 
+	if (undo_dirty) {
+		glulx_free(undo_dirty);
+		undo_dirty = nullptr;
+	}
+	if (undo_shadow) {
+		glulx_free(undo_shadow);
+		undo_shadow = nullptr;
+	}
+	undo_pagecount = 0;
+
 #ifdef SERIALIZE_CACHE_RAM
 	if (ramcache) {
 		glulx_free(ramcache);
@@ -71,17 +81,71 @@ void Glulx::final_serial() {
 #endif /* SERIALIZE_CACHE_RAM */
 }
 
+uint Glulx::undo_resize(uint newlen) {
+	uint count = (newlen + UNDO_PAGE_SIZE - 1) >> UNDO_PAGE_SHIFT;
+	byte *newdirty, *newshadow;
+
+	if (count <= undo_pagecount)
+		return 0;
+
+	newdirty = (byte *)glulx_realloc(undo_dirty, count);
+	if (!newdirty)
+		return 1;
+	undo_dirty = newdirty;
+
+	newshadow = (byte *)glulx_realloc(undo_shadow, count << UNDO_PAGE_SHIFT);
+	if (!newshadow)
+		return 1;
+	undo_shadow = newshadow;
+
+	/* New pages have no snapshot contents yet, so they start out dirty. */
+	memset(undo_dirty + undo_pagecount, 1, count - undo_pagecount);
+	memset(undo_shadow + (undo_pagecount << UNDO_PAGE_SHIFT), 0, (count - undo_pagecount) << UNDO_PAGE_SHIFT);
+	undo_pagecount = count;
+
+	return 0;
+}
+
+void Glulx::undo_mark_dirty(uint addr, uint len) {
+	uint page;
+
+	if (len == 0)
+		return;
+
+	for (page = addr >> UNDO_PAGE_SHIFT; page <= ((addr + len - 1) >> UNDO_PAGE_SHIFT) && page < undo_pagecount; page++)
+		undo_dirty[page] = 1;
+}
+
+void Glulx::undo_discard() {
+	int ix;
+
+	for (ix = 0; ix < undo_chain_num; ix++) {
+		glulx_free(undo_chain[ix]);
+		undo_chain[ix] = nullptr;
+	}
+	undo_chain_num = 0;
+}
+
 uint Glulx::perform_saveundo() {
 	dest_t dest;
 	uint res;
-	uint memstart = 0, memlen = 0, heapstart = 0, heaplen = 0;
+	uint heapstart = 0, heaplen = 0;
 	uint stackstart = 0, stacklen = 0;
+	uint pagestart = 0, pagecount = 0;
+	uint page, addr;
 
 	/* The format for undo-saves is simpler than for saves on disk. We
-	   just have a memory chunk, a heap chunk, and a stack chunk, in
-	   that order. We skip the IFF chunk headers (although the size
-	   fields are still there.) We also don't bother with IFF's 16-bit
-	   alignment. */
+	   have the memory size, a heap chunk, a stack chunk, and then a list
+	   of memory pages, in that order. We skip the IFF chunk headers
+	   (although the size fields are still there.) We also don't bother
+	   with IFF's 16-bit alignment.
+
+	   Main memory is not stored in full. The page list only contains the
+	   pages dirtied since the previous snapshot, holding their contents
+	   as of that snapshot; the current contents move into undo_shadow.
+	   Restoring this entry therefore means reverting the dirty pages from
+	   undo_shadow, then applying the page list to undo_shadow so that it
+	   matches the next entry down the chain. */
 
 	if (undo_chain_size == 0)
 		return 1;
@@ -90,12 +154,7 @@ uint Glulx::perform_saveundo() {
 
 	res = 0;
 	if (res == 0) {
-		res = write_long(&dest, 0); /* space for chunk length */
-	}
-	if (res == 0) {
-		memstart = dest._pos;
-		res = write_memstate(&dest);
-		memlen = dest._pos - memstart;
+		res = write_long(&dest, endmem);
 	}
 	if (res == 0) {
 		res = write_long(&dest, 0); /* space for chunk length */
@@ -113,6 +172,32 @@ uint Glulx::perform_saveundo() {
 		res = write_stackstate(&dest, false);
 		stacklen = dest._pos - stackstart;
 	}
+	if (res == 0) {
+		res = write_long(&dest, 0); /* space for page count */
+		pagestart = dest._pos;
+	}
+
+	if (res == 0 && undo_chain_num == 0) {
+		/* Nothing to step back to, so just take a full copy of memory. */
+		memcpy(undo_shadow, memmap, endmem);
+		memset(undo_dirty, 0, undo_pagecount);
+	}
+
+	for (page = 0; res == 0 && page < undo_pagecount; page++) {
+		if (!undo_dirty[page])
+			continue;
+
+		addr = page << UNDO_PAGE_SHIFT;
+		res = write_long(&dest, page);
+		if (res == 0)
+			res = write_buffer(&dest, undo_shadow + addr, UNDO_PAGE_SIZE);
+		if (res == 0) {
+			if (addr < endmem)
+				memcpy(undo_shadow + addr, memmap + addr, UNDO_PAGE_SIZE);
+			undo_dirty[page] = 0;
+			pagecount++;
+		}
+	}
 
 	if (res == 0) {
 		/* Trim it down to the perfect size. */
@@ -120,12 +205,6 @@ uint Glulx::perform_saveundo() {
 		if (!dest._ptr)
 			res = 1;
 	}
-	if (res == 0) {
-		res = reposition_write(&dest, memstart - 4);
-	}
-	if (res == 0) {
-		res = write_long(&dest, memlen);
-	}
 	if (res == 0) {
 		res = reposition_write(&dest, heapstart - 4);
 	}
@@ -138,6 +217,12 @@ uint Glulx::perform_saveundo() {
 	if (res == 0) {
 		res = write_long(&dest, stacklen);
 	}
+	if (res == 0) {
+		res = reposition_write(&dest, pagestart - 4);
+	}
+	if (res == 0) {
+		res = write_long(&dest, pagecount);
+	}
 
 	if (res == 0) {
 		/* It worked. */
@@ -153,11 +238,13 @@ uint Glulx::perform_saveundo() {
 			undo_chain_num += 1;
 		dest._ptr = nullptr;
 	} else {
-		/* It didn't work. */
+		/* It didn't work. The shadow copy may be half updated, so the
+		   older entries can no longer be reconstructed. */
 		if (dest._ptr) {
 			glulx_free(dest._ptr);
 			dest._ptr = nullptr;
 		}
+		undo_discard();
 	}
 
 	return res;
@@ -168,6 +255,8 @@ uint Glulx::perform_restoreundo() {
 	uint res, val = 0;
 	uint heapsumlen = 0;
 	uint *heapsumarr = nullptr;
+	uint pagecount = 0;
+	uint page, addr, lx;
 
 	/* If profiling is enabled and active then fail. */
 #ifdef VM_PROFILING
@@ -186,7 +275,32 @@ uint Glulx::perform_restoreundo() {
 		res = read_long(&dest, &val);
 	}
 	if (res == 0) {
-		res = read_memstate(&dest, val);
+		heap_clear();
+		res = change_memsize(val, false);
+	}
+	if (res == 0) {
+		/* Revert everything written since the snapshot was taken. */
+		for (page = 0; page < undo_pagecount; page++) {
+			if (!undo_dirty[page])
+				continue;
+			undo_dirty[page] = 0;
+
+			addr = page << UNDO_PAGE_SHIFT;
+			if (addr >= endmem)
+				continue;
+			if (addr + UNDO_PAGE_SIZE <= protectstart || addr >= protectend) {
+				memcpy(memmap + addr, undo_shadow + addr, UNDO_PAGE_SIZE);
+			} else {
+				for (lx = addr; lx < addr + UNDO_PAGE_SIZE; lx++) {
+					if (lx < protectstart || lx >= protectend)
+						memmap[lx] = undo_shadow[lx];
+				}
+			}
+		}
+
+		/* The protected range was left alone, so it may not match the shadow copy. */
+		if (protectend > protectstart)
+			undo_mark_dirty(protectstart, protectend - protectstart);
 	}
 	if (res == 0) {
 		res = read_long(&dest, &val);
@@ -200,6 +314,20 @@ uint Glulx::perform_restoreundo() {
 	if (res == 0) {
 		res = read_stackstate(&dest, val, false);
 	}
+	if (res == 0) {
+		res = read_long(&dest, &pagecount);
+	}
+	/* Step the shadow copy back to the next snapshot down the chain. The
+	   pages that differ are exactly the ones that are now dirty. */
+	for (lx = 0; res == 0 && lx < pagecount; lx++) {
+		res = read_long(&dest, &page);
+		if (res == 0 && page >= undo_pagecount)
+			res = 1;
+		if (res == 0)
+			res = read_buffer(&dest, undo_shadow + (page << UNDO_PAGE_SHIFT), UNDO_PAGE_SIZE);
+		if (res == 0)
+			undo_dirty[page] = 1;
+	}
 	/* ### really, many of the failure modes of those calls ought to
 	   cause fatal errors. The stack or main memory may be damaged now. */
 
@@ -217,8 +345,10 @@ uint Glulx::perform_restoreundo() {
 		glulx_free(dest._ptr);
 		dest._ptr = nullptr;
 	} else {
-		/* It didn't work. */
+		/* It didn't work. Memory and the shadow copy may be partially
+		   reverted, so the remaining entries can't be trusted either. */
 		dest._ptr = nullptr;
+		undo_discard();
 	}
 
 	return res;
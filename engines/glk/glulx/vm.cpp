@@ -20,6 +20,7 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "common/debug-channels.h"
 
 namespace Glk {
 namespace Glulx {
@@ -89,7 +90,9 @@ void Glulx::setup_vm() {
 
 	// Initialize various other things in the terp.
 	init_operands();
-	init_serial();
+	profile_set_call_counts(DebugMan.isDebugChannelEnabled(kDebugScripts));
+	if (!init_serial())
+		fatal_error("Unable to allocate Glulx undo space.");
 
 	// Set up the initial machine state.
 	vm_restart();
@@ -105,6 +108,12 @@ void Glulx::setup_vm() {
 
 void Glulx::finalize_vm() {
 	stream_set_table(0);
+	profile_report_call_counts();
+
+	if (decode_cache) {
+		glulx_free(decode_cache);
+		decode_cache = nullptr;
+	}
 
 	if (memmap) {
 		glulx_free(memmap);
@@ -154,6 +163,7 @@ void Glulx::vm_restart() {
 	for (lx = endgamefile; lx < origendmem; lx++) {
 		memmap[lx] = 0;
 	}
+	undo_mark_dirty(0, origendmem);
 
 	/* Reset all the registers */
 	stackptr = 0;
@@ -193,6 +203,9 @@ uint Glulx::change_memsize(uint newlen, bool internal) {
 	if (newlen & 0xFF)
 		fatal_error("Can only resize Glulx memory space to a 256-byte boundary.");
 
+	if (undo_resize(newlen))
+		return 1;
+
 	newmemmap = (unsigned char *)glulx_realloc(memmap, newlen);
 	if (!newmemmap) {
 		/* The old block is still in place, unchanged. */
@@ -204,6 +217,7 @@ uint Glulx::change_memsize(uint newlen, bool internal) {
 		for (lx = endmem; lx < newlen; lx++) {
 			memmap[lx] = 0;
 		}
+		undo_mark_dirty(endmem, newlen - endmem);
 	}
 
 	endmem = newlen;
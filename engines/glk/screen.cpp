@@ -186,4 +186,9 @@ size_t Screen::stringWidthUni(int fontIdx, const Common::U32String &text, int sp
 	return font->getStringWidth(text) * GLI_SUBPIX;
 }
 
+int Screen::charWidthUni(int fontIdx, uint32 prev, uint32 ch) {
+	const Graphics::Font *font = _fonts[fontIdx];
+	return (font->getCharWidth(ch) + font->getKerningOffset(prev, ch)) * GLI_SUBPIX;
+}
+
 } // End of namespace Glk
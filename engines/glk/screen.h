@@ -132,6 +132,16 @@ public:
 	 * @returns         Width of string multiplied by GLI_SUBPIX
 	 */
 	size_t stringWidthUni(int fontIdx, const Common::U32String &text, int spw = 0);
+
+	/**
+	 * Get how much a character adds to the width of a run of text. Summing this over a
+	 * string gives the same result as stringWidthUni
+	 * @param fontIdx   Which font to use
+	 * @param prev      Preceding character in the same run, or 0 at the start of a run
+	 * @param ch        Character to get the width of
+	 * @returns         Advance of the character, including kerning, multiplied by GLI_SUBPIX
+	 */
+	int charWidthUni(int fontIdx, uint32 prev, uint32 ch);
 };
 
 } // End of namespace Glk
@@ -40,8 +40,9 @@ TextBufferWindow::TextBufferWindow(Windows *windows, uint rock) : TextWindow(win
 		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK), _width(-1), _height(-1),
 		_inBuf(nullptr), _lineTerminators(nullptr), _echoLineInput(true), _ladjw(0), _radjw(0),
 		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _spaced(0), _dashed(0),
-		_copyBuf(nullptr), _copyPos(0) {
+		_copyBuf(nullptr), _copyPos(0), _widthsValid(0) {
 	_type = wintype_TextBuffer;
+	_widths[0] = 0;
 	_history.resize(HISTORYLEN);
 
 	_lines.resize(SCROLLBACK);
@@ -309,6 +310,7 @@ void TextBufferWindow::putText(const char *buf, int len, int pos, int oldlen) {
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	invalidateWidths(pos);
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -341,6 +343,7 @@ void TextBufferWindow::putTextUni(const uint32 *buf, int len, int pos, int oldle
 	if (_numChars + diff >= TBLINELEN)
 		return;
 
+	invalidateWidths(pos);
 	if (diff != 0 && pos + oldlen < _numChars) {
 		memmove(_chars + pos + len,
 				_chars + pos + oldlen,
@@ -478,6 +481,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 		}
 	}
 
+	invalidateWidths(_numChars);
 	_chars[_numChars] = ch;
 	_attrs[_numChars] = _attr;
 	_numChars++;
@@ -489,7 +493,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 			&& !_styles[_attrs[linelen - 1].style].reverse)
 		linelen--;
 
-	if (calcWidth(_chars, _attrs, 0, linelen, -1) >= pw) {
+	if (lineWidth(linelen) >= pw) {
 		bpoint = _numChars;
 
 		for (i = _numChars - 1; i > 0; i--) {
@@ -541,6 +545,7 @@ void TextBufferWindow::clear() {
 	_dashed = 0;
 
 	_numChars = 0;
+	invalidateWidths(0);
 
 	for (i = 0; i < _scrollBack; i++) {
 		_lines[i]._len = 0;
@@ -1549,7 +1554,8 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
+	// Rows past _scrollMax have never held text, so only the live ones need moving
+	for (int i = _scrollMax; i > 0; i--) {
 		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
 		if (i < _height)
 			touch(i);
@@ -1580,6 +1586,7 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 		a->clear();
 
 	_numChars = 0;
+	invalidateWidths(0);
 
 	touchScroll();
 
@@ -1617,6 +1624,10 @@ int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, in
 	int w = 0;
 	int a, b;
 
+	// Widths don't depend on spw, so the last line can always be served from the cache
+	if (chars == _chars && startchar == 0)
+		return lineWidth(numChars);
+
 	a = startchar;
 	for (b = startchar; b < numChars; b++) {
 		if (attrs[a] != attrs[b]) {
@@ -1631,6 +1642,19 @@ int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, in
 	return w;
 }
 
+int TextBufferWindow::lineWidth(int numChars) {
+	Screen &screen = *g_vm->_screen;
+
+	for (; _widthsValid < numChars; _widthsValid++) {
+		int i = _widthsValid;
+		// Kerning only applies within a run of identical attributes, as in calcWidth
+		uint32 prev = (i > 0 && _attrs[i - 1] == _attrs[i]) ? _chars[i - 1] : 0;
+		_widths[i + 1] = _widths[i] + screen.charWidthUni(_attrs[i].attrFont(_styles), prev, _chars[i]);
+	}
+
+	return _widths[numChars];
+}
+
 void TextBufferWindow::getSize(uint *width, uint *height) const {
 	if (width)
 		*width = (_bbox.width() - g_conf->_tMarginX * 2) / _font._cellW;
@@ -91,6 +91,19 @@ private:
 	void scrollOneLine(bool forced);
 	void scrollResize();
 	int calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numchars, int spw);
+
+	/**
+	 * Returns the width of the first numChars characters of the last line, as calcWidth would,
+	 * measuring only characters that aren't already in the width cache
+	 */
+	int lineWidth(int numChars);
+
+	/**
+	 * Discard cached widths from the given character of the last line onwards
+	 */
+	void invalidateWidths(int pos) {
+		_widthsValid = MIN(_widthsValid, pos);
+	}
 public:
 	int _width, _height;
 	int _spaced;
@@ -103,6 +116,14 @@ public:
 	uint32 *_chars;       ///< alias to lines[0].chars
 	Attributes *_attrs;   ///< alias to lines[0].attrs
 
+	/**
+	 * Width cache for the last line: _widths[n] is the width of its first n characters,
+	 * valid for n <= _widthsValid. Appending a character only has to measure that character,
+	 * rather than the whole line as it wraps
+	 */
+	int _widths[TBLINELEN + 1];
+	int _widthsValid;
+
 	///< adjust margins temporarily for images
 	int _ladjw;
 	int _ladjn;
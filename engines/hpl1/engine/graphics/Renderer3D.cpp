@@ -250,6 +250,9 @@ cRenderer3D::~cRenderer3D() {
 void cRenderSettings::Clear() {
 	mlLastShadowAlgo = 0;
 
+	mlShadowTrianglesExtruded = 0;
+	mlShadowVolumesCached = 0;
+
 	mbDepthTest = true;
 
 	mAlphaMode = eMaterialAlphaMode_Solid;
@@ -399,6 +402,9 @@ void cRenderer3D::RenderWorld(cWorld3D *apWorld, cCamera3D *apCamera, float afFr
 	if (mbLog)
 		Log("Rendering Lighting:\n");
 	RenderLight(apCamera);
+	if (mbLog)
+		Log("Shadow volumes: %d triangles extruded, %d reused from cache\n",
+			mRenderSettings.mlShadowTrianglesExtruded, mRenderSettings.mlShadowVolumesCached);
 
 	////////////////////////////
 	// Render Diffuse
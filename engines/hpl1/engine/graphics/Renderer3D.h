@@ -107,6 +107,10 @@ public:
 	// State settings
 	int mlLastShadowAlgo;
 
+	// Statistics
+	int mlShadowTrianglesExtruded;
+	int mlShadowVolumesCached;
+
 	bool mbDepthTest;
 
 	eMaterialAlphaMode mAlphaMode;
@@ -207,8 +207,10 @@ bool iLight3D::HasStaticCasters() {
 }
 
 void iLight3D::ClearCasters(bool abClearStatic) {
-	if (abClearStatic)
+	if (abClearStatic) {
 		m_setStaticCasters.clear();
+		m_mapShadowVolumeCache.clear();
+	}
 	m_setDynamicCasters.clear();
 }
 
@@ -360,13 +362,13 @@ bool iLight3D::BeginDraw(cRenderSettings *apRenderSettings, iLowLevelGraphics *a
 		if (apRenderSettings->mShowShadows == eRendererShowShadows_All) {
 			it = m_setDynamicCasters.begin();
 			for (; it != m_setDynamicCasters.end(); ++it) {
-				RenderShadow(*it, apRenderSettings, apLowLevelGraphics);
+				RenderShadow(*it, apRenderSettings, apLowLevelGraphics, false);
 			}
 		}
 
 		it = m_setStaticCasters.begin();
 		for (; it != m_setStaticCasters.end(); ++it) {
-			RenderShadow(*it, apRenderSettings, apLowLevelGraphics);
+			RenderShadow(*it, apRenderSettings, apLowLevelGraphics, true);
 		}
 
 		// Make rendering ready for the objects.
@@ -540,9 +542,7 @@ void iLight3D::RemoveBillboard(cBillboard *apBillboard) {
 //-----------------------------------------------------------------------
 
 void iLight3D::RenderShadow(iRenderable *apObject, cRenderSettings *apRenderSettings,
-							iLowLevelGraphics *apLowLevelGraphics) {
-	int lIndexCount = 0;
-
+							iLowLevelGraphics *apLowLevelGraphics, bool abStatic) {
 	////////////////////////////////////////////////////////////////////////
 	// Check if the shadow volume collides with the frustum
 	cShadowVolumeBV *pVolume = apObject->GetBoundingVolume()->GetShadowVolume(
@@ -562,7 +562,6 @@ void iLight3D::RenderShadow(iRenderable *apObject, cRenderSettings *apRenderSett
 		Log("Rendering shadow for '%s'\n", apObject->GetName().c_str());
 
 	cSubMeshEntity *pSubEntity = static_cast<cSubMeshEntity *>(apObject);
-	cSubMesh *pSubMesh = pSubEntity->GetSubMesh();
 
 	//////////////////////////////////////////
 	// Check what method to use.
@@ -607,10 +606,6 @@ void iLight3D::RenderShadow(iRenderable *apObject, cRenderSettings *apRenderSett
 		}
 	}
 
-	//////////////////////////////////////////
-	// Check if the cache as data.
-	/* TO BE IMPLEMENTED*/
-
 	///////////////////////////////////////////
 	// Get local light position
 	cVector3f vLocalLight = GetWorldPosition();
@@ -630,6 +625,109 @@ void iLight3D::RenderShadow(iRenderable *apObject, cRenderSettings *apRenderSett
 		apLowLevelGraphics->SetMatrix(eMatrix_ModelView, apRenderSettings->mpCamera->GetViewMatrix());
 	}
 
+	/////////////////////////////////////////////////////////
+	// Build the shadow volume, static casters only need to do this
+	// when the light has moved.
+	unsigned int *pIndexArray = mpIndexArray;
+	int lIndexCount;
+	if (abStatic) {
+		tShadowVolumeCacheMapIt cacheIt = m_mapShadowVolumeCache.find(apObject);
+		if (cacheIt != m_mapShadowVolumeCache.end() && cacheIt->_value.mbZFail == bZFail &&
+			cacheIt->_value.mvLocalLight == vLocalLight) {
+			pIndexArray = cacheIt->_value.mvIndices.data();
+			lIndexCount = (int)cacheIt->_value.mvIndices.size();
+			apRenderSettings->mlShadowVolumesCached++;
+		} else {
+			lIndexCount = ExtrudeShadowVolume(pSubEntity, vLocalLight, bZFail);
+			apRenderSettings->mlShadowTrianglesExtruded += lIndexCount / 3;
+
+			cShadowVolumeCache &cache = m_mapShadowVolumeCache[apObject];
+			cache.mvLocalLight = vLocalLight;
+			cache.mbZFail = bZFail;
+			cache.mvIndices.resize(lIndexCount);
+			if (lIndexCount > 0)
+				memcpy(cache.mvIndices.data(), mpIndexArray, lIndexCount * sizeof(unsigned int));
+		}
+	} else {
+		lIndexCount = ExtrudeShadowVolume(pSubEntity, vLocalLight, bZFail);
+		apRenderSettings->mlShadowTrianglesExtruded += lIndexCount / 3;
+	}
+
+	///////////////////////////////////////////////////////
+	// Draw the volume:
+
+	// Set light position and model view matrix, this does not have to be set if last
+	// object was static.
+	if (pModelMtx || apRenderSettings->mbMatrixWasNULL == false) {
+		apRenderSettings->extrudeProgram->SetVec3f("lightPosition", vLocalLight);
+		apRenderSettings->extrudeProgram->SetMatrixf("worldViewProj",
+													 eGpuProgramMatrix_ViewProjection,
+													 eGpuProgramMatrixOp_Identity);
+
+		// If a null matrix has been set, let other passes know.
+		if (pModelMtx)
+			apRenderSettings->mbMatrixWasNULL = false;
+		else
+			apRenderSettings->mbMatrixWasNULL = true;
+	}
+
+	// Set vertex buffer
+	if (apRenderSettings->mpVtxBuffer != pSubEntity->GetVertexBuffer()) {
+		if (apRenderSettings->mbLog)
+			Log(" Setting vertex buffer %d\n", (size_t)pSubEntity->GetVertexBuffer());
+
+		pSubEntity->GetVertexBuffer()->Bind();
+		apRenderSettings->mpVtxBuffer = pSubEntity->GetVertexBuffer();
+	}
+
+	// Draw vertex buffer
+	if (apLowLevelGraphics->GetCaps(eGraphicCaps_TwoSideStencil)) {
+		pSubEntity->GetVertexBuffer()->DrawIndices(pIndexArray, lIndexCount);
+		if (apRenderSettings->mbLog)
+			Log(" Drawing front and back simultaneously.\n");
+	} else {
+		if (apRenderSettings->mbLog)
+			Log(" Drawing front and back separately.\n");
+
+		if (bZFail) {
+			// Front
+			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
+										   eStencilOp_Keep, eStencilOp_DecrementWrap, eStencilOp_Keep);
+			pSubEntity->GetVertexBuffer()->DrawIndices(pIndexArray, lIndexCount);
+
+			// Back
+			apLowLevelGraphics->SetCullMode(eCullMode_Clockwise);
+			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
+										   eStencilOp_Keep, eStencilOp_IncrementWrap, eStencilOp_Keep);
+			pSubEntity->GetVertexBuffer()->DrawIndices(pIndexArray, lIndexCount);
+		} else {
+			// Front
+			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
+										   eStencilOp_Keep, eStencilOp_Keep, eStencilOp_IncrementWrap);
+			pSubEntity->GetVertexBuffer()->DrawIndices(pIndexArray, lIndexCount);
+
+			// Back
+			apLowLevelGraphics->SetCullMode(eCullMode_Clockwise);
+			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
+										   eStencilOp_Keep, eStencilOp_Keep, eStencilOp_DecrementWrap);
+			pSubEntity->GetVertexBuffer()->DrawIndices(pIndexArray, lIndexCount);
+		}
+
+		apLowLevelGraphics->SetCullMode(eCullMode_CounterClockwise);
+	}
+
+	if (apLowLevelGraphics->GetCaps(eGraphicCaps_TwoSideStencil)) {
+		apLowLevelGraphics->SetStencilTwoSide(false);
+		apRenderSettings->mlLastShadowAlgo = 0;
+	}
+}
+
+//-----------------------------------------------------------------------
+
+int iLight3D::ExtrudeShadowVolume(cSubMeshEntity *pSubEntity, const cVector3f &vLocalLight, bool bZFail) {
+	cSubMesh *pSubMesh = pSubEntity->GetSubMesh();
+	int lIndexCount = 0;
+
 	/////////////////////////////////////////////////////////
 	// Get the data arrays
 	const float *pPosArray = pSubEntity->GetVertexBuffer()->GetArray(eVertexFlag_Position);
@@ -748,73 +846,7 @@ void iLight3D::RenderShadow(iRenderable *apObject, cRenderSettings *apRenderSett
 		}
 	}
 
-	///////////////////////////////////////////////////////
-	// Draw the volume:
-
-	// Set light position and model view matrix, this does not have to be set if last
-	// object was static.
-	if (pModelMtx || apRenderSettings->mbMatrixWasNULL == false) {
-		apRenderSettings->extrudeProgram->SetVec3f("lightPosition", vLocalLight);
-		apRenderSettings->extrudeProgram->SetMatrixf("worldViewProj",
-													 eGpuProgramMatrix_ViewProjection,
-													 eGpuProgramMatrixOp_Identity);
-
-		// If a null matrix has been set, let other passes know.
-		if (pModelMtx)
-			apRenderSettings->mbMatrixWasNULL = false;
-		else
-			apRenderSettings->mbMatrixWasNULL = true;
-	}
-
-	// Set vertex buffer
-	if (apRenderSettings->mpVtxBuffer != pSubEntity->GetVertexBuffer()) {
-		if (apRenderSettings->mbLog)
-			Log(" Setting vertex buffer %d\n", (size_t)pSubEntity->GetVertexBuffer());
-
-		pSubEntity->GetVertexBuffer()->Bind();
-		apRenderSettings->mpVtxBuffer = pSubEntity->GetVertexBuffer();
-	}
-
-	// Draw vertex buffer
-	if (apLowLevelGraphics->GetCaps(eGraphicCaps_TwoSideStencil)) {
-		pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
-		if (apRenderSettings->mbLog)
-			Log(" Drawing front and back simultaneously.\n");
-	} else {
-		if (apRenderSettings->mbLog)
-			Log(" Drawing front and back separately.\n");
-
-		if (bZFail) {
-			// Front
-			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
-										   eStencilOp_Keep, eStencilOp_DecrementWrap, eStencilOp_Keep);
-			pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
-
-			// Back
-			apLowLevelGraphics->SetCullMode(eCullMode_Clockwise);
-			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
-										   eStencilOp_Keep, eStencilOp_IncrementWrap, eStencilOp_Keep);
-			pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
-		} else {
-			// Front
-			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
-										   eStencilOp_Keep, eStencilOp_Keep, eStencilOp_IncrementWrap);
-			pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
-
-			// Back
-			apLowLevelGraphics->SetCullMode(eCullMode_Clockwise);
-			apLowLevelGraphics->SetStencil(eStencilFunc_Always, 0, 0x0,
-										   eStencilOp_Keep, eStencilOp_Keep, eStencilOp_DecrementWrap);
-			pSubEntity->GetVertexBuffer()->DrawIndices(mpIndexArray, lIndexCount);
-		}
-
-		apLowLevelGraphics->SetCullMode(eCullMode_CounterClockwise);
-	}
-
-	if (apLowLevelGraphics->GetCaps(eGraphicCaps_TwoSideStencil)) {
-		apLowLevelGraphics->SetStencilTwoSide(false);
-		apRenderSettings->mlLastShadowAlgo = 0;
-	}
+	return lIndexCount;
 }
 
 //-----------------------------------------------------------------------
@@ -28,6 +28,9 @@
 #ifndef HPL_LIGHT3D_H
 #define HPL_LIGHT3D_H
 
+#include "common/array.h"
+#include "common/hash-ptr.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "hpl1/engine/graphics/GraphicsTypes.h"
 #include "hpl1/engine/graphics/Renderable.h"
@@ -63,10 +66,22 @@ class cResources;
 class cFileSearcher;
 class cBillboard;
 class cSectorVisibilityContainer;
+class cSubMeshEntity;
 
 typedef Hpl1::Std::set<iRenderable *> tCasterCacheSet;
 typedef tCasterCacheSet::iterator tCasterCacheSetIt;
 
+// Shadow volume indices of a static caster, valid as long as the light
+// (in the caster's local space) and the shadow algorithm stay the same.
+struct cShadowVolumeCache {
+	cVector3f mvLocalLight;
+	bool mbZFail;
+	Common::Array<unsigned int> mvIndices;
+};
+
+typedef Common::HashMap<iRenderable *, cShadowVolumeCache> tShadowVolumeCacheMap;
+typedef tShadowVolumeCacheMap::iterator tShadowVolumeCacheMapIt;
+
 //------------------------------------------
 
 kSaveData_ChildClass(iRenderable, iLight3D) {
@@ -164,7 +179,8 @@ public:
 
 	cMatrixf *GetModelMatrix(cCamera3D *apCamera);
 
-	inline void RenderShadow(iRenderable *apObject, cRenderSettings *apRenderSettings, iLowLevelGraphics *apLowLevelGraphics);
+	inline void RenderShadow(iRenderable *apObject, cRenderSettings *apRenderSettings, iLowLevelGraphics *apLowLevelGraphics,
+							 bool abStatic);
 
 	void LoadXMLProperties(const tString asFile);
 
@@ -190,6 +206,8 @@ protected:
 	void OnSetDiffuse();
 
 	virtual cSectorVisibilityContainer *CreateSectorVisibility() = 0;
+
+	int ExtrudeShadowVolume(cSubMeshEntity *pSubEntity, const cVector3f &vLocalLight, bool bZFail);
 	virtual void ExtraXMLProperties(TiXmlElement *apMainElem) {}
 	virtual void UpdateBoundingVolume() = 0;
 	virtual bool CreateClipRect(cRect2l &aCliprect, cRenderSettings *apRenderSettings, iLowLevelGraphics *apLowLevelGraphics) = 0;
@@ -210,6 +228,8 @@ protected:
 	tCasterCacheSet m_setStaticCasters;
 	tCasterCacheSet m_setDynamicCasters;
 
+	tShadowVolumeCacheMap m_mapShadowVolumeCache;
+
 	bool mbStaticCasterAdded;
 
 	bool mbOnlyAffectInInSector;
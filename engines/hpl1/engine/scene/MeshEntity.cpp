@@ -322,6 +322,7 @@ cMeshEntity::cMeshEntity(const tString asName, cMesh *apMesh, cMaterialManager *
 
 		// Create an array to fill with bone matrices
 		mvBoneMatrices.resize(pSkeleton->GetBoneNum());
+		mvSkinMatrices.resize(pSkeleton->GetBoneNum());
 
 		// Reset all bones states
 		for (size_t i = 0; i < mvBoneStates.size(); i++) {
@@ -1145,6 +1146,8 @@ void cMeshEntity::UpdateGraphics(cCamera3D *apCamera, float afFrameTime, cRender
 			cMatrixf mtxLocal = cMath::MatrixMul(*pInvWorldMtx, pState->GetWorldMatrix());
 
 			mvBoneMatrices[i] = cMath::MatrixMul(mtxLocal, pBone->GetInvWorldTransform());
+			// Both are row major
+			mvSkinMatrices[i].setData(mvBoneMatrices[i].v);
 		}
 
 		// Set back the matrix.
@@ -40,6 +40,7 @@
 #include "common/array.h"
 #include "hpl1/engine/scene/AnimationState.h"
 #include "common/stablemap.h"
+#include "math/matrix4.h"
 
 namespace hpl {
 
@@ -242,6 +243,8 @@ private:
 	tNodeStateVec mvTempBoneStates;
 
 	Common::Array<cMatrixf> mvBoneMatrices;
+	// The same matrices, for skinning with Math::Matrix4::transformAdd
+	Common::Array<Math::Matrix4> mvSkinMatrices;
 
 	bool mbSkeletonPhysics;
 	bool mbSkeletonPhysicsFading;
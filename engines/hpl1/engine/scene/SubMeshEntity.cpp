@@ -148,36 +148,6 @@ iMaterial *cSubMeshEntity::GetMaterial() {
 
 //-----------------------------------------------------------------------
 
-// Set Src as private variable to give this a little boost! Or?
-static inline void MatrixFloatTransformSet(float *pDest, const cMatrixf &a_mtxA, const float *pSrc, const float fWeight) {
-	pDest[0] = (a_mtxA.m[0][0] * pSrc[0] + a_mtxA.m[0][1] * pSrc[1] + a_mtxA.m[0][2] * pSrc[2] + a_mtxA.m[0][3]) * fWeight;
-	pDest[1] = (a_mtxA.m[1][0] * pSrc[0] + a_mtxA.m[1][1] * pSrc[1] + a_mtxA.m[1][2] * pSrc[2] + a_mtxA.m[1][3]) * fWeight;
-	pDest[2] = (a_mtxA.m[2][0] * pSrc[0] + a_mtxA.m[2][1] * pSrc[1] + a_mtxA.m[2][2] * pSrc[2] + a_mtxA.m[2][3]) * fWeight;
-}
-
-static inline void MatrixFloatRotateSet(float *pDest, const cMatrixf &a_mtxA, const float *pSrc, const float fWeight) {
-	pDest[0] = (a_mtxA.m[0][0] * pSrc[0] + a_mtxA.m[0][1] * pSrc[1] + a_mtxA.m[0][2] * pSrc[2]) * fWeight;
-	pDest[1] = (a_mtxA.m[1][0] * pSrc[0] + a_mtxA.m[1][1] * pSrc[1] + a_mtxA.m[1][2] * pSrc[2]) * fWeight;
-	pDest[2] = (a_mtxA.m[2][0] * pSrc[0] + a_mtxA.m[2][1] * pSrc[1] + a_mtxA.m[2][2] * pSrc[2]) * fWeight;
-}
-
-////////////////////////////////////////////////////////////
-
-// Set Src as private variable to give this a little boost!Or?
-static inline void MatrixFloatTransformAdd(float *pDest, const cMatrixf &a_mtxA, const float *pSrc, const float fWeight) {
-	pDest[0] += (a_mtxA.m[0][0] * pSrc[0] + a_mtxA.m[0][1] * pSrc[1] + a_mtxA.m[0][2] * pSrc[2] + a_mtxA.m[0][3]) * fWeight;
-	pDest[1] += (a_mtxA.m[1][0] * pSrc[0] + a_mtxA.m[1][1] * pSrc[1] + a_mtxA.m[1][2] * pSrc[2] + a_mtxA.m[1][3]) * fWeight;
-	pDest[2] += (a_mtxA.m[2][0] * pSrc[0] + a_mtxA.m[2][1] * pSrc[1] + a_mtxA.m[2][2] * pSrc[2] + a_mtxA.m[2][3]) * fWeight;
-}
-
-static inline void MatrixFloatRotateAdd(float *pDest, const cMatrixf &a_mtxA, const float *pSrc, const float fWeight) {
-	pDest[0] += (a_mtxA.m[0][0] * pSrc[0] + a_mtxA.m[0][1] * pSrc[1] + a_mtxA.m[0][2] * pSrc[2]) * fWeight;
-	pDest[1] += (a_mtxA.m[1][0] * pSrc[0] + a_mtxA.m[1][1] * pSrc[1] + a_mtxA.m[1][2] * pSrc[2]) * fWeight;
-	pDest[2] += (a_mtxA.m[2][0] * pSrc[0] + a_mtxA.m[2][1] * pSrc[1] + a_mtxA.m[2][2] * pSrc[2]) * fWeight;
-}
-
-////////////////////////////////////////////////////////////
-
 void cSubMeshEntity::UpdateGraphics(cCamera3D *apCamera, float afFrameTime, cRenderList *apRenderList) {
 	if (mpDynVtxBuffer) {
 		if (mpMeshEntity->mbSkeletonPhysicsSleeping && mbGraphicsUpdated) {
@@ -207,44 +177,26 @@ void cSubMeshEntity::UpdateGraphics(cCamera3D *apCamera, float afFrameTime, cRen
 
 			const unsigned char *pBoneIdx = &mpSubMesh->mpVertexBones[vtx * 4];
 
-			{
-				const cMatrixf &mtxTransform = mpMeshEntity->mvBoneMatrices[*pBoneIdx];
-
-				// Log("Vtx: %d\n",vtx);
-				// Log("Boneidx: %d Count %d Weight: %f vtx: %d\n",(int)*pBoneIdx,lCount, *pWeight,vtx);
-
-				// ATTENTION: Some optimizing might be done by accumulating the matrix instead.
-				// THIS is really unsure since it seems like it will result in more math, matrix mul = 8*4 calc
-				// Vertex mul with matrix is 3 * 3 calculations
-				// this means: vertex= 9*3 = 27, matrix = 32
-
-				MatrixFloatTransformSet(pSkinPos, mtxTransform, pBindPos, *pWeight);
-
-				MatrixFloatRotateSet(pSkinNormal, mtxTransform, pBindNormal, *pWeight);
-
-				MatrixFloatRotateSet(pSkinTangent, mtxTransform, pBindTangent, *pWeight);
-
-				++pWeight;
-				++pBoneIdx;
-				++lCount;
-			}
+			pSkinPos[0] = pSkinPos[1] = pSkinPos[2] = 0;
+			pSkinNormal[0] = pSkinNormal[1] = pSkinNormal[2] = 0;
+			pSkinTangent[0] = pSkinTangent[1] = pSkinTangent[2] = 0;
 
 			// Iterate weights until 0 is found or count < 4
-			while (*pWeight != 0 && lCount < 4) {
+			do {
 				// Log("Boneidx: %d Count %d Weight: %f\n",(int)*pBoneIdx,lCount, *pWeight);
-				const cMatrixf &mtxTransform = mpMeshEntity->mvBoneMatrices[*pBoneIdx];
+				const Math::Matrix4 &mtxTransform = mpMeshEntity->mvSkinMatrices[*pBoneIdx];
 
 				// Transform with the local movement of the bone.
-				MatrixFloatTransformAdd(pSkinPos, mtxTransform, pBindPos, *pWeight);
+				mtxTransform.transformAdd(pSkinPos, pBindPos, *pWeight, true);
 
-				MatrixFloatRotateAdd(pSkinNormal, mtxTransform, pBindNormal, *pWeight);
+				mtxTransform.transformAdd(pSkinNormal, pBindNormal, *pWeight, false);
 
-				MatrixFloatRotateAdd(pSkinTangent, mtxTransform, pBindTangent, *pWeight);
+				mtxTransform.transformAdd(pSkinTangent, pBindTangent, *pWeight, false);
 
 				++pWeight;
 				++pBoneIdx;
 				++lCount;
-			}
+			} while (*pWeight != 0 && lCount < 4);
 
 			pBindPos += lVtxStride;
 			pSkinPos += lVtxStride;
@@ -380,7 +380,30 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		int slotNum = atoi(slotStr);
 
 		if (slotNum >= 0 && slotNum <= getMaximumSaveSlot()) {
+			// Opening every savefile is slow on large save directories,
+			// so the descriptors of unchanged files are kept around.
+			uint32 revision;
+			const bool cacheable = saveFileMan->getSavefileRevision(*file, revision);
+			if (cacheable) {
+				Common::HashMap<Common::String, CachedSaveMetaInfos>::const_iterator cached = _saveMetaInfosCache.find(*file);
+				if (cached != _saveMetaInfosCache.end() && cached->_value.revision == revision) {
+					if (cached->_value.desc.getSaveSlot() != -1)
+						saveList.push_back(cached->_value.desc);
+					continue;
+				}
+			}
+
 			SaveStateDescriptor desc = querySaveMetaInfos(target, slotNum);
+			// Thumbnails are not needed to list the saves, the save/load
+			// dialogs query the slots they show.
+			desc.setThumbnail(nullptr);
+
+			if (cacheable) {
+				CachedSaveMetaInfos &cached = _saveMetaInfosCache[*file];
+				cached.revision = revision;
+				cached.desc = desc;
+			}
+
 			if (desc.getSaveSlot() != -1) {
 				saveList.push_back(desc);
 			}
@@ -26,6 +26,8 @@
 #include "common/error.h"
 #include "common/array.h"
 #include "common/debug-channels.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 
 #include "engines/achievements.h"
 #include "engines/game.h"
@@ -222,6 +224,19 @@ protected:
 		return ExtraGuiOptions();
 	}
 
+private:
+	struct CachedSaveMetaInfos {
+		uint32 revision;
+		SaveStateDescriptor desc;
+	};
+
+	/**
+	 * Descriptors (without thumbnail) returned by querySaveMetaInfos for
+	 * the default listSaves, by savefile name. An entry is reused for as long
+	 * as the savefile manager reports the same revision for the file.
+	 */
+	mutable Common::HashMap<Common::String, CachedSaveMetaInfos> _saveMetaInfosCache;
+
 public:
 	virtual ~MetaEngine() {}
 
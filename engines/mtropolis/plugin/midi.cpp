@@ -92,6 +92,8 @@ public:
 
 protected:
 	bool processEvent(const EventInfo &info, bool fireEvents) override;
+	// The tempo override can change between jumps, so snapshots of the tempo go stale
+	bool supportsJumpSnapshots() const override { return false; }
 
 private:
 	double _tempoOverride;
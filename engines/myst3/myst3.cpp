@@ -214,9 +214,11 @@ Common::Error Myst3Engine::run() {
 		}
 
 		drawFrame();
+		prefetchNextFace();
 	}
 
 	unloadNode();
+	clearFaceCache();
 
 	_archiveNode->close();
 	_gfx->freeFont();
@@ -854,6 +856,9 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 
 		Common::String nodeFile = Common::String::format("%snodes.m3a", newRoomName.c_str());
 
+		// The cached faces reference the directory of the archive being closed
+		clearFaceCache();
+
 		_archiveNode->close();
 		if (!_archiveNode->open(nodeFile.c_str(), newRoomName.c_str())) {
 			error("Unable to open archive %s", nodeFile.c_str());
@@ -865,6 +870,8 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 		return; // The main init script does not load a node
 	}
 
+	queueReachableNodes();
+
 	// The effects can only be created after running the node init scripts
 	_node->initEffects();
 	_shakeEffect = ShakeEffect::create(this);
@@ -1410,6 +1417,125 @@ Graphics::Surface *Myst3Engine::decodeJpeg(const ResourceDescription *jpegDesc)
 	return rgbaSurface;
 }
 
+Graphics::Surface *Myst3Engine::decodeNodeJpeg(const ResourceDescription *jpegDesc) {
+	Graphics::Surface *cached = findCachedFace(*jpegDesc);
+	if (!cached) {
+		cached = decodeJpeg(jpegDesc);
+		addCachedFace(*jpegDesc, cached);
+	}
+
+	// The faces draw the spot items directly onto their bitmap, hand out a copy
+	Graphics::Surface *surface = new Graphics::Surface();
+	surface->copyFrom(*cached);
+	return surface;
+}
+
+Graphics::Surface *Myst3Engine::findCachedFace(const ResourceDescription &desc) {
+	for (Common::List<DecodedFace>::iterator it = _faceCache.begin(); it != _faceCache.end(); it++) {
+		if (it->desc == desc) {
+			DecodedFace face = *it;
+			_faceCache.erase(it);
+			_faceCache.push_front(face);
+			return face.surface;
+		}
+	}
+
+	return nullptr;
+}
+
+void Myst3Engine::addCachedFace(const ResourceDescription &desc, Graphics::Surface *surface) {
+	// Enough for the current node and the faces of a couple of neighbors
+	static const uint kMaxCachedFaces = 24;
+
+	while (_faceCache.size() >= kMaxCachedFaces) {
+		_faceCache.back().surface->free();
+		delete _faceCache.back().surface;
+		_faceCache.pop_back();
+	}
+
+	DecodedFace face;
+	face.desc = desc;
+	face.surface = surface;
+	_faceCache.push_front(face);
+}
+
+void Myst3Engine::clearFaceCache() {
+	for (Common::List<DecodedFace>::iterator it = _faceCache.begin(); it != _faceCache.end(); it++) {
+		it->surface->free();
+		delete it->surface;
+	}
+
+	_faceCache.clear();
+	_facePrefetchQueue.clear();
+}
+
+void Myst3Engine::queueNodeFaces(uint16 nodeID) {
+	// Same lookups as NodeCube and NodeFrame
+	for (uint i = 0; i < 6; i++) {
+		ResourceDescription desc = getFileDescription("", nodeID, i + 1, Archive::kCubeFace);
+		if (desc.isValid())
+			_facePrefetchQueue.push_back(desc);
+	}
+
+	ResourceDescription desc = getFileDescription("", nodeID, 1, Archive::kLocalizedFrame);
+
+	if (!desc.isValid())
+		desc = getFileDescription("", nodeID, 0, Archive::kFrame);
+
+	if (!desc.isValid())
+		desc = getFileDescription("", nodeID, 1, Archive::kFrame);
+
+	if (desc.isValid())
+		_facePrefetchQueue.push_back(desc);
+}
+
+void Myst3Engine::queueReachableNodes() {
+	_facePrefetchQueue.clear();
+
+	NodePtr nodeData = _db->getNodeData(_state->getLocationNode(), _state->getLocationRoom(), _state->getLocationAge());
+	if (!nodeData)
+		return;
+
+	// Collect the destinations of the node change opcodes of the current node's hotspots.
+	// Only literal node ids in the current room are considered, room changes
+	// open a different archive anyway.
+	Common::Array<uint16> reachable;
+	for (uint i = 0; i < nodeData->hotspots.size(); i++) {
+		const Common::Array<Opcode> &script = nodeData->hotspots[i].script;
+		for (uint j = 0; j < script.size(); j++) {
+			const Opcode &cmd = script[j];
+
+			if (!_scriptEngine->isNodeChangeOpcode(cmd) || cmd.args.empty() || cmd.args[0] <= 0)
+				continue;
+
+			uint16 nodeID = cmd.args[0];
+			if (nodeID != _state->getLocationNode() && Common::find(reachable.begin(), reachable.end(), nodeID) == reachable.end())
+				reachable.push_back(nodeID);
+		}
+	}
+
+	// Don't queue more than the cache can hold alongside the current node
+	for (uint i = 0; i < reachable.size() && _facePrefetchQueue.size() < 18; i++) {
+		queueNodeFaces(reachable[i]);
+	}
+
+	debugC(kDebugNode, "Queued %d faces from %d reachable nodes for prefetching", _facePrefetchQueue.size(), reachable.size());
+}
+
+void Myst3Engine::prefetchNextFace() {
+	// Decode at most one face per frame so the frame rate is not affected
+	while (!_facePrefetchQueue.empty()) {
+		ResourceDescription desc = _facePrefetchQueue.back();
+		_facePrefetchQueue.pop_back();
+
+		if (findCachedFace(desc))
+			continue;
+
+		addCachedFace(desc, decodeJpeg(&desc));
+		return;
+	}
+}
+
 int16 Myst3Engine::openDialog(uint16 id) {
 	Dialog *dialog;
 
@@ -25,6 +25,7 @@
 #include "engines/engine.h"
 
 #include "common/array.h"
+#include "common/list.h"
 #include "common/ptr.h"
 #include "common/system.h"
 #include "common/random.h"
@@ -132,6 +133,7 @@ public:
 
 	Graphics::Surface *loadTexture(uint16 id);
 	static Graphics::Surface *decodeJpeg(const ResourceDescription *jpegDesc);
+	Graphics::Surface *decodeNodeJpeg(const ResourceDescription *jpegDesc);
 
 	void goToNode(uint16 nodeID, TransitionType transition);
 	void loadNode(uint16 nodeID, uint32 roomID = 0, uint32 ageID = 0);
@@ -198,6 +200,23 @@ private:
 	Common::Array<Archive *> _archivesCommon;
 	Archive *_archiveNode;
 
+	struct DecodedFace {
+		ResourceDescription desc;
+		Graphics::Surface *surface;
+	};
+
+	// Recently decoded node faces, most recently used first
+	Common::List<DecodedFace> _faceCache;
+	// Faces of the nodes reachable from the current one, decoded one per frame
+	Common::Array<ResourceDescription> _facePrefetchQueue;
+
+	Graphics::Surface *findCachedFace(const ResourceDescription &desc);
+	void addCachedFace(const ResourceDescription &desc, Graphics::Surface *surface);
+	void clearFaceCache();
+	void queueNodeFaces(uint16 nodeID);
+	void queueReachableNodes();
+	void prefetchNextFace();
+
 	Script *_scriptEngine;
 
 	Common::Array<ScriptedMovie *> _movies;
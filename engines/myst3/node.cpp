@@ -33,7 +33,7 @@
 namespace Myst3 {
 
 void Face::setTextureFromJPEG(const ResourceDescription *jpegDesc) {
-	_bitmap = Myst3Engine::decodeJpeg(jpegDesc);
+	_bitmap = _vm->decodeNodeJpeg(jpegDesc);
 	if (_is3D) {
 		_texture = _vm->_gfx->createTexture3D(_bitmap);
 	} else {
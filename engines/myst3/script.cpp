@@ -33,6 +33,7 @@
 #include "engines/myst3/state.h"
 
 #include "common/events.h"
+#include "common/tracing.h"
 
 namespace Myst3 {
 
@@ -293,6 +294,8 @@ Script::~Script() {
 }
 
 bool Script::run(const Common::Array<Opcode> *script) {
+	TRACE_ZONE("Myst3::Script::run");
+
 	debugC(kDebugScript, "Script start %p", (const void *) script);
 
 	Context c;
@@ -333,6 +336,13 @@ const Script::Command &Script::findCommandByProc(CommandProc proc) {
 	return findCommand(0);
 }
 
+bool Script::isNodeChangeOpcode(const Opcode &opcode) {
+	// Compare the procs, the opcode numbers depend on the platform
+	CommandProc proc = findCommand(opcode.op).proc;
+	return proc == &Script::goToNodeTransition || proc == &Script::goToNodeTrans2
+			|| proc == &Script::goToNodeTrans1 || proc == &Script::changeNode;
+}
+
 void Script::shiftCommands(uint16 base, int32 value) {
 	for (uint16 i = 0; i < _commands.size(); i++)
 		if (_commands[i].op >= base)
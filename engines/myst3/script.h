@@ -42,6 +42,9 @@ public:
 
 	const Common::String describeOpcode(const Opcode &opcode);
 
+	/** Is the opcode one of those changing the current node, taking the node id as its first argument */
+	bool isNodeChangeOpcode(const Opcode &opcode);
+
 private:
 	struct Context {
 		bool endScript;
@@ -502,19 +502,26 @@ Audio::RewindableAudioStream *SoundChannel::makeAudioStream(const Common::String
 	if (!s)
 		error("Unable to open sound file '%s'", filename.toString().c_str());
 
+	Audio::SeekableAudioStream *compressedStream;
 	if (isMP3) {
 #ifdef USE_MAD
-		return Audio::makeMP3Stream(s, DisposeAfterUse::YES);
+		compressedStream = Audio::makeMP3Stream(s, DisposeAfterUse::YES);
 #else
 		warning("Unable to play sound '%s', MP3 support is not compiled in.", filename.toString().c_str());
 		delete s;
 		return NULL;
 #endif
 	} else if (isWMA) {
-		return Audio::makeASFStream(s, DisposeAfterUse::YES);
+		compressedStream = Audio::makeASFStream(s, DisposeAfterUse::YES);
 	} else {
 		return Audio::makeWAVStream(s, DisposeAfterUse::YES);
 	}
+
+	// Many sounds can play at once, decode them ahead of the mixer
+	if (!compressedStream)
+		return NULL;
+
+	return Audio::makePrefetchingAudioStream(compressedStream);
 }
 
 void SoundChannel::update() {
@@ -172,6 +172,64 @@ Common::Rect TinyGLDriver::getUnscaledViewport() const {
 	return _unscaledViewport;
 }
 
+Math::Vector3d TinyGLDriver::computeVertexLight(const Math::Vector3d &eyePosition, const Math::Vector3d &eyeNormal,
+                                                const LightEntryArray &lights) {
+	static const uint maxLights = 10;
+
+	assert(lights.size() >= 1);
+	assert(lights.size() <= maxLights);
+
+	const LightEntry *ambient = lights[0];
+	assert(ambient->type == LightEntry::kAmbient); // The first light must be the ambient light
+
+	Math::Vector3d lightColor = ambient->color;
+
+	for (uint li = 0; li < lights.size() - 1; li++) {
+		const LightEntry *l = lights[li + 1];
+
+		switch (l->type) {
+			case LightEntry::kPoint: {
+				Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - eyePosition;
+
+				float dist = vertexToLight.length();
+				vertexToLight.normalize();
+				float attn = CLIP((l->falloffFar - dist) / MAX(0.001f,  l->falloffFar - l->falloffNear), 0.0f, 1.0f);
+				float incidence = MAX(0.0f, Math::Vector3d::dotProduct(eyeNormal, vertexToLight));
+				lightColor += l->color * attn * incidence;
+				break;
+			}
+			case LightEntry::kDirectional: {
+				float incidence = MAX(0.0f, Math::Vector3d::dotProduct(eyeNormal, -l->eyeDirection));
+				lightColor += (l->color * incidence);
+				break;
+			}
+			case LightEntry::kSpot: {
+				Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - eyePosition;
+
+				float dist = vertexToLight.length();
+				float attn = CLIP((l->falloffFar - dist) / MAX(0.001f, l->falloffFar - l->falloffNear), 0.0f, 1.0f);
+
+				vertexToLight.normalize();
+				float incidence = MAX(0.0f, eyeNormal.dotProduct(vertexToLight));
+
+				float cosAngle = MAX(0.0f, vertexToLight.dotProduct(-l->eyeDirection));
+				float cone = CLIP((cosAngle - l->innerConeAngle.getCosine()) / MAX(0.001f, l->outerConeAngle.getCosine() - l->innerConeAngle.getCosine()), 0.0f, 1.0f);
+
+				lightColor += l->color * attn * incidence * cone;
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	lightColor.x() = CLIP(lightColor.x(), 0.0f, 1.0f);
+	lightColor.y() = CLIP(lightColor.y(), 0.0f, 1.0f);
+	lightColor.z() = CLIP(lightColor.z(), 0.0f, 1.0f);
+
+	return lightColor;
+}
+
 Graphics::Surface *TinyGLDriver::getViewportScreenshot() const {
 	Graphics::Surface *tmp = TinyGL::copyFromFrameBuffer(getRGBAPixelFormat());
 	Graphics::Surface *s = new Graphics::Surface();
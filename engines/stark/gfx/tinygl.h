@@ -63,6 +63,15 @@ public:
 	Common::Rect getUnscaledViewport() const;
 	void setupLights(const LightEntryArray &lights);
 
+	/**
+	 * Compute the light reaching a vertex, clamped to [0, 1]
+	 *
+	 * Positions and directions are in eye space.
+	 * The first light must be the ambient light.
+	 */
+	static Math::Vector3d computeVertexLight(const Math::Vector3d &eyePosition, const Math::Vector3d &eyeNormal,
+	                                         const LightEntryArray &lights);
+
 	Graphics::Surface *getViewportScreenshot() const override;
 
 	bool supportsModdedAssets() const override { return false; }
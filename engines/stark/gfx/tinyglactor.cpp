@@ -94,9 +94,62 @@ void TinyGLActorRenderer::render(const Math::Vector3d &position, float direction
 		lightDirection = getShadowLightDirection(lights, position, modelInverse.getRotation());
 	}
 
-	Common::Array<Face *> faces = _model->getFaces();
-	Common::Array<Material *> mats = _model->getMaterials();
+	const Common::Array<Face *> &faces = _model->getFaces();
+	const Common::Array<Material *> &mats = _model->getMaterials();
 	const Common::Array<BoneNode *> &bones = _model->getBones();
+	const Math::Matrix3 normalRotation = normalMatrix.getRotation();
+
+	// Skin and light each vertex once, faces share most of their vertices.
+	// The material color depends on the face, so only the light is stored here.
+	uint32 vertexCount = _model->getVertices().size();
+	for (uint32 index = 0; index < vertexCount; index++) {
+		ActorVertex &vertex = _faceVBO[index];
+		const BoneNode *bone1 = bones[vertex.bone1];
+		const BoneNode *bone2 = bones[vertex.bone2];
+		Math::Vector3d position1 = Math::Vector3d(vertex.pos1x, vertex.pos1y, vertex.pos1z);
+		Math::Vector3d position2 = Math::Vector3d(vertex.pos2x, vertex.pos2y, vertex.pos2z);
+		float boneWeight = vertex.boneWeight;
+		Math::Vector3d normal = Math::Vector3d(vertex.normalx, vertex.normaly, vertex.normalz);
+
+		// Compute the vertex position in eye-space
+		bone1->_animRot.transform(position1);
+		position1 += bone1->_animPos;
+		bone2->_animRot.transform(position2);
+		position2 += bone2->_animPos;
+		Math::Vector3d modelPosition = Math::Vector3d::interpolate(position2, position1, boneWeight);
+		vertex.x = modelPosition.x();
+		vertex.y = modelPosition.y();
+		vertex.z = modelPosition.z();
+		Math::Vector4d modelEyePosition;
+		modelEyePosition = modelViewMatrix * Math::Vector4d(modelPosition.x(),
+		                                                    modelPosition.y(),
+		                                                    modelPosition.z(),
+		                                                    1.0);
+		// Compute the vertex normal in eye-space
+		Math::Vector3d n1 = normal;
+		bone1->_animRot.transform(n1);
+		Math::Vector3d n2 = normal;
+		bone2->_animRot.transform(n2);
+		Math::Vector3d modelNormal = Math::Vector3d(Math::Vector3d::interpolate(n2, n1, boneWeight)).getNormalized();
+		vertex.nx = modelNormal.x();
+		vertex.ny = modelNormal.y();
+		vertex.nz = modelNormal.z();
+		Math::Vector3d modelEyeNormal;
+		modelEyeNormal = normalRotation * modelNormal;
+		modelEyeNormal.normalize();
+
+		if (drawShadow) {
+			Math::Vector3d shadowPosition = modelPosition + lightDirection * (-modelPosition.y() / lightDirection.y());
+			vertex.sx = shadowPosition.x();
+			vertex.sy = 0.0f;
+			vertex.sz = shadowPosition.z();
+		}
+
+		Math::Vector3d lightColor = TinyGLDriver::computeVertexLight(modelEyePosition.getXYZ(), modelEyeNormal, lights);
+		vertex.lr = lightColor.x();
+		vertex.lg = lightColor.y();
+		vertex.lb = lightColor.z();
+	}
 
 	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
 		const Material *material = mats[(*face)->materialId];
@@ -105,132 +158,19 @@ void TinyGLActorRenderer::render(const Math::Vector3d &position, float direction
 		if (tex) {
 			tex->bind();
 			tglEnable(TGL_TEXTURE_2D);
+			color = Math::Vector3d(1.0f, 1.0f, 1.0f);
 		} else {
 			tglBindTexture(TGL_TEXTURE_2D, 0);
 			tglDisable(TGL_TEXTURE_2D);
+			color = Math::Vector3d(material->r, material->g, material->b);
 		}
 		auto vertexIndices = _faceEBO[*face];
 		auto numVertexIndices = (*face)->vertexIndices.size();
 		for (uint32 i = 0; i < numVertexIndices; i++) {
-			if (tex) {
-				color = Math::Vector3d(1.0f, 1.0f, 1.0f);
-			} else {
-				color = Math::Vector3d(material->r, material->g, material->b);
-			}
-			uint32 index = vertexIndices[i];
-			auto vertex = _faceVBO[index];
-			uint32 bone1 = vertex.bone1;
-			uint32 bone2 = vertex.bone2;
-			Math::Vector3d position1 = Math::Vector3d(vertex.pos1x, vertex.pos1y, vertex.pos1z);
-			Math::Vector3d position2 = Math::Vector3d(vertex.pos2x, vertex.pos2y, vertex.pos2z);
-			Math::Vector3d bone1Position = Math::Vector3d(bones[bone1]->_animPos.x(),
-			                                              bones[bone1]->_animPos.y(),
-			                                              bones[bone1]->_animPos.z());
-			Math::Vector3d bone2Position = Math::Vector3d(bones[bone2]->_animPos.x(),
-			                                              bones[bone2]->_animPos.y(),
-			                                              bones[bone2]->_animPos.z());
-			Math::Quaternion bone1Rotation = Math::Quaternion(bones[bone1]->_animRot.x(),
-			                                                  bones[bone1]->_animRot.y(),
-			                                                  bones[bone1]->_animRot.z(),
-			                                                  bones[bone1]->_animRot.w());
-			Math::Quaternion bone2Rotation = Math::Quaternion(bones[bone2]->_animRot.x(),
-			                                                  bones[bone2]->_animRot.y(),
-			                                                  bones[bone2]->_animRot.z(),
-			                                                  bones[bone2]->_animRot.w());
-			float boneWeight = vertex.boneWeight;
-			Math::Vector3d normal = Math::Vector3d(vertex.normalx, vertex.normaly, vertex.normalz);
-
-			// Compute the vertex position in eye-space
-			bone1Rotation.transform(position1);
-			position1 += bone1Position;
-			bone2Rotation.transform(position2);
-			position2 += bone2Position;
-			Math::Vector3d modelPosition = Math::Vector3d::interpolate(position2, position1, boneWeight);
-			vertex.x = modelPosition.x();
-			vertex.y = modelPosition.y();
-			vertex.z = modelPosition.z();
-			Math::Vector4d modelEyePosition;
-			modelEyePosition = modelViewMatrix * Math::Vector4d(modelPosition.x(),
-			                                                    modelPosition.y(),
-			                                                    modelPosition.z(),
-			                                                    1.0);
-			// Compute the vertex normal in eye-space
-			Math::Vector3d n1 = normal;
-			bone1Rotation.transform(n1);
-			Math::Vector3d n2 = normal;
-			bone2Rotation.transform(n2);
-			Math::Vector3d modelNormal = Math::Vector3d(Math::Vector3d::interpolate(n2, n1, boneWeight)).getNormalized();
-			vertex.nx = modelNormal.x();
-			vertex.ny = modelNormal.y();
-			vertex.nz = modelNormal.z();
-			Math::Vector3d modelEyeNormal;
-			modelEyeNormal = normalMatrix.getRotation() * modelNormal;
-			modelEyeNormal.normalize();
-
-			if (drawShadow) {
-				Math::Vector3d shadowPosition = modelPosition + lightDirection * (-modelPosition.y() / lightDirection.y());
-				vertex.sx = shadowPosition.x();
-				vertex.sy = 0.0f;
-				vertex.sz = shadowPosition.z();
-			}
-
-			static const uint maxLights = 10;
-
-			assert(lights.size() >= 1);
-			assert(lights.size() <= maxLights);
-
-			const LightEntry *ambient = lights[0];
-			assert(ambient->type == LightEntry::kAmbient); // The first light must be the ambient light
-
-			Math::Vector3d lightColor = ambient->color;
-
-			for (uint li = 0; li < lights.size() - 1; li++) {
-				const LightEntry *l = lights[li + 1];
-
-				switch (l->type) {
-					case LightEntry::kPoint: {
-						Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - modelEyePosition.getXYZ();
-
-						float dist = vertexToLight.length();
-						vertexToLight.normalize();
-						float attn = CLIP((l->falloffFar - dist) / MAX(0.001f,  l->falloffFar - l->falloffNear), 0.0f, 1.0f);
-						float incidence = MAX(0.0f, Math::Vector3d::dotProduct(modelEyeNormal, vertexToLight));
-						lightColor += l->color * attn * incidence;
-						break;
-					}
-					case LightEntry::kDirectional: {
-						float incidence = MAX(0.0f, Math::Vector3d::dotProduct(modelEyeNormal, -l->eyeDirection));
-						lightColor += (l->color * incidence);
-						break;
-					}
-					case LightEntry::kSpot: {
-						Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - modelEyePosition.getXYZ();
-
-						float dist = vertexToLight.length();
-						float attn = CLIP((l->falloffFar - dist) / MAX(0.001f, l->falloffFar - l->falloffNear), 0.0f, 1.0f);
-
-						vertexToLight.normalize();
-						float incidence = MAX(0.0f, modelEyeNormal.dotProduct(vertexToLight));
-
-						float cosAngle = MAX(0.0f, vertexToLight.dotProduct(-l->eyeDirection));
-						float cone = CLIP((cosAngle - l->innerConeAngle.getCosine()) / MAX(0.001f, l->outerConeAngle.getCosine() - l->innerConeAngle.getCosine()), 0.0f, 1.0f);
-
-						lightColor += l->color * attn * incidence * cone;
-						break;
-					}
-					default:
-						break;
-				}
-			}
-
-			lightColor.x() = CLIP(lightColor.x(), 0.0f, 1.0f);
-			lightColor.y() = CLIP(lightColor.y(), 0.0f, 1.0f);
-			lightColor.z() = CLIP(lightColor.z(), 0.0f, 1.0f);
-			color = color * lightColor;
-			vertex.r = color.x();
-			vertex.g = color.y();
-			vertex.b = color.z();
-			_faceVBO[index] = vertex;
+			ActorVertex &vertex = _faceVBO[vertexIndices[i]];
+			vertex.r = color.x() * vertex.lr;
+			vertex.g = color.y() * vertex.lg;
+			vertex.b = color.z() * vertex.lb;
 		}
 
 		tglEnableClientState(TGL_VERTEX_ARRAY);
@@ -63,6 +63,9 @@ struct _ActorVertex {
 	float r;
 	float g;
 	float b;
+	float lr;
+	float lg;
+	float lb;
 };
 typedef _ActorVertex ActorVertex;
 
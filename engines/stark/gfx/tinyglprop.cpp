@@ -71,6 +71,23 @@ void TinyGLPropRenderer::render(const Math::Vector3d &position, float direction,
 
 	const Common::Array<Face> &faces = _model->getFaces();
 	const Common::Array<Material> &materials = _model->getMaterials();
+	const Math::Matrix3 normalRotation = normalMatrix.getRotation();
+
+	// Light each vertex once, faces share most of their vertices.
+	// The material color depends on the face, so only the light is stored here.
+	uint32 vertexCount = _model->getVertices().size();
+	for (uint32 index = 0; index < vertexCount; index++) {
+		PropVertex &vertex = _faceVBO[index];
+
+		Math::Vector4d modelEyePosition = modelViewMatrix * Math::Vector4d(vertex.x, vertex.y, vertex.z, 1.0);
+		Math::Vector3d modelEyeNormal = normalRotation * Math::Vector3d(vertex.nx, vertex.ny, vertex.nz);
+		modelEyeNormal.normalize();
+
+		Math::Vector3d lightColor = TinyGLDriver::computeVertexLight(modelEyePosition.getXYZ(), modelEyeNormal, lights);
+		vertex.lr = lightColor.x();
+		vertex.lg = lightColor.y();
+		vertex.lb = lightColor.z();
+	}
 
 	for (Common::Array<Face>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
 		const Material &material = materials[face->materialId];
@@ -79,17 +96,17 @@ void TinyGLPropRenderer::render(const Math::Vector3d &position, float direction,
 		if (tex) {
 			tex->bind();
 			tglEnable(TGL_TEXTURE_2D);
+			color = Math::Vector3d(1.0f, 1.0f, 1.0f);
 		} else {
 			tglBindTexture(TGL_TEXTURE_2D, 0);
 			tglDisable(TGL_TEXTURE_2D);
+			color = Math::Vector3d(material.r, material.g, material.b);
 		}
 		auto vertexIndices = _faceEBO[face];
 		auto numVertexIndices = (face)->vertexIndices.size();
 		for (uint32 i = 0; i < numVertexIndices; i++) {
-			uint32 index = vertexIndices[i];
-			auto vertex = _faceVBO[index];
+			PropVertex &vertex = _faceVBO[vertexIndices[i]];
 			if (tex) {
-				color = Math::Vector3d(1.0f, 1.0f, 1.0f);
 				if (material.doubleSided) {
 					vertex.texS = vertex.stexS;
 					vertex.texT = 1.0f - vertex.stexT;
@@ -97,71 +114,10 @@ void TinyGLPropRenderer::render(const Math::Vector3d &position, float direction,
 					vertex.texS = 1.0f - vertex.stexS;
 					vertex.texT = 1.0f - vertex.stexT;
 				}
-			} else {
-				color = Math::Vector3d(material.r, material.g, material.b);
-			}
-
-			Math::Vector4d modelEyePosition = modelViewMatrix * Math::Vector4d(vertex.x, vertex.y, vertex.z, 1.0);
-			Math::Vector3d modelEyeNormal = normalMatrix.getRotation() *  Math::Vector3d(vertex.nx, vertex.ny, vertex.nz);
-			modelEyeNormal.normalize();
-
-			static const uint maxLights = 10;
-
-			assert(lights.size() >= 1);
-			assert(lights.size() <= maxLights);
-
-			const LightEntry *ambient = lights[0];
-			assert(ambient->type == LightEntry::kAmbient); // The first light must be the ambient light
-
-			Math::Vector3d lightColor = ambient->color;
-
-			for (uint li = 0; li < lights.size() - 1; li++) {
-				const LightEntry *l = lights[li + 1];
-
-				switch (l->type) {
-					case LightEntry::kPoint: {
-						Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - modelEyePosition.getXYZ();
-
-						float dist = vertexToLight.length();
-						vertexToLight.normalize();
-						float attn = CLIP((l->falloffFar - dist) / MAX(0.001f,  l->falloffFar - l->falloffNear), 0.0f, 1.0f);
-						float incidence = MAX(0.0f, Math::Vector3d::dotProduct(modelEyeNormal, vertexToLight));
-						lightColor += l->color * attn * incidence;
-						break;
-					}
-					case LightEntry::kDirectional: {
-						float incidence = MAX(0.0f, Math::Vector3d::dotProduct(modelEyeNormal, -l->eyeDirection));
-						lightColor += (l->color * incidence);
-						break;
-					}
-					case LightEntry::kSpot: {
-						Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - modelEyePosition.getXYZ();
-
-						float dist = vertexToLight.length();
-						float attn = CLIP((l->falloffFar - dist) / MAX(0.001f, l->falloffFar - l->falloffNear), 0.0f, 1.0f);
-
-						vertexToLight.normalize();
-						float incidence = MAX(0.0f, modelEyeNormal.dotProduct(vertexToLight));
-
-						float cosAngle = MAX(0.0f, vertexToLight.dotProduct(-l->eyeDirection));
-						float cone = CLIP((cosAngle - l->innerConeAngle.getCosine()) / MAX(0.001f, l->outerConeAngle.getCosine() - l->innerConeAngle.getCosine()), 0.0f, 1.0f);
-
-						lightColor += l->color * attn * incidence * cone;
-						break;
-					}
-					default:
-						break;
-				}
 			}
-
-			lightColor.x() = CLIP(lightColor.x(), 0.0f, 1.0f);
-			lightColor.y() = CLIP(lightColor.y(), 0.0f, 1.0f);
-			lightColor.z() = CLIP(lightColor.z(), 0.0f, 1.0f);
-			color = color * lightColor;
-			vertex.r = color.x();
-			vertex.g = color.y();
-			vertex.b = color.z();
-			_faceVBO[index] = vertex;
+			vertex.r = color.x() * vertex.lr;
+			vertex.g = color.y() * vertex.lg;
+			vertex.b = color.z() * vertex.lb;
 		}
 
 		tglEnableClientState(TGL_VERTEX_ARRAY);
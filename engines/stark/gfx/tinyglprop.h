@@ -51,6 +51,9 @@ struct _PropVertex {
 	float r;
 	float g;
 	float b;
+	float lr;
+	float lg;
+	float lb;
 };
 typedef _PropVertex PropVertex;
 
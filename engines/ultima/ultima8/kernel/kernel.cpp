@@ -25,6 +25,8 @@
 #include "ultima/ultima8/misc/id_man.h"
 #include "ultima/ultima8/ultima8.h"
 
+#include "common/tracing.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -144,6 +146,8 @@ ProcId Kernel::addProcessExec(Process *proc, bool dispose) {
 }
 
 void Kernel::runProcesses() {
+	TRACE_ZONE("Ultima8::Kernel::runProcesses");
+
 	if (!_paused)
 		_tickNum++;
 
@@ -28,6 +28,7 @@
 #include "ultima/ultima8/world/item.h"
 #include "ultima/ultima8/world/get_object.h"
 #include "ultima/ultima8/world/world.h"
+#include "ultima/ultima8/world/current_map.h"
 #include "ultima/ultima8/world/actors/pathfinder.h"
 #include "ultima/ultima8/misc/direction_util.h"
 #include "ultima/ultima8/kernel/kernel.h"
@@ -285,11 +286,23 @@ void CruPathfinderProcess::run() {
 		terminate(); // _destpt.z != npcpt.z
 		return;
 	}
+
+	// Walks which cannot take a single step are usually started again right
+	// away (e.g. by AttackProcess), so skip them until something changes.
+	CurrentMap *map = World::get_instance()->getCurrentMap();
+	const FailedPathSearch search(_itemNum, _targetItem, false, true, npcpt, _target);
+	if (_currentStep == 0 && map->hasPathRecentlyFailed(search)) {
+		terminate(); //0
+		return;
+	}
+
 	const Direction lastdir = _nextDir;
 	_nextDir = nextDirFromPoint(npcpt);
 	_lastDir = lastdir;
 	if (_nextDir == dir_current) {
-	   terminate(); //0
+		if (_currentStep == 0)
+			map->addFailedPath(search);
+		terminate(); //0
 		return;
 	}
 
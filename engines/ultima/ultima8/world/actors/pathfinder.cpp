@@ -24,6 +24,8 @@
 #include "ultima/ultima8/misc/direction_util.h"
 #include "ultima/ultima8/world/actors/actor.h"
 #include "ultima/ultima8/world/actors/animation_tracker.h"
+#include "ultima/ultima8/world/current_map.h"
+#include "ultima/ultima8/world/world.h"
 
 #ifdef DEBUG_PATHFINDER
 #include "graphics/screen.h"
@@ -47,8 +49,19 @@ struct PathNode {
 	uint32 stepsfromparent;
 };
 
-// NOTE: this is just to keep some statistics
-static unsigned int expandednodes = 0;
+// NOTE: these are just to keep some statistics
+static unsigned int totalsearches = 0;
+static unsigned int totalexpandednodes = 0;
+static unsigned int failurecachehits = 0;
+
+// Size of the xy buckets used to look up visited points. Points closer than
+// 8 units count as visited, so only the neighbouring buckets need checking.
+static const int VISITED_CELL_SHIFT = 4;
+
+static uint32 visitedCellKey(int32 x, int32 y) {
+	return (static_cast<uint32>(x >> VISITED_CELL_SHIFT) & 0xFFFF) |
+	       ((static_cast<uint32>(y >> VISITED_CELL_SHIFT) & 0xFFFF) << 16);
+}
 
 void PathfindingState::load(const Actor *_actor) {
 	_point = _actor->getLocation();
@@ -115,14 +128,16 @@ bool PathNodeCmp::operator()(const PathNode *n1, const PathNode *n2) const {
 
 Pathfinder::Pathfinder() : _actor(nullptr), _targetItem(nullptr),
 		_hitMode(false), _expandTime(0), _target(),
-		_actorXd(0), _actorYd(0), _actorZd(0) {
-	expandednodes = 0;
+		_actorXd(0), _actorYd(0), _actorZd(0), _expandedNodes(0) {
 	_visited.reserve(1500);
 }
 
 Pathfinder::~Pathfinder() {
 	debugC(kDebugPath, "~Pathfinder: %u nodes to clean up, visited %u and %u expanded nodes in %dms.",
-		_cleanupNodes.size(), _visited.size(), expandednodes, _expandTime);
+		_cleanupNodes.size(), _visited.size(), _expandedNodes, _expandTime);
+	if (totalsearches)
+		debugC(kDebugPath, "Pathfinder: %u searches, %u expanded nodes on average, %u failures reused.",
+			totalsearches, totalexpandednodes / totalsearches, failurecachehits);
 
 	// clean up _nodes
 	Std::vector<PathNode *>::iterator iter;
@@ -171,23 +186,36 @@ bool Pathfinder::canReach() {
 }
 
 bool Pathfinder::alreadyVisited(const Point3 &pt) const {
-	//
-	// There are more efficient search structures we could use for
-	// this, but for the number of points we end up having even on
-	// pathfind failure (~1200) the fancy structures don't justify
-	// their extra overhead.
-	//
-	// Linear search of an array is just as fast, or slightly faster.
-	//
-	Common::Array<PathfindingState>::const_iterator iter;
-	for (iter = _visited.begin(); iter != _visited.end(); iter++) {
-		if (iter->checkPoint(pt, 8*8))
-			return true;
+	for (int dx = -1; dx <= 1; dx++) {
+		for (int dy = -1; dy <= 1; dy++) {
+			const int32 cx = pt.x + dx * (1 << VISITED_CELL_SHIFT);
+			const int32 cy = pt.y + dy * (1 << VISITED_CELL_SHIFT);
+			Common::HashMap<uint32, Common::Array<uint>>::const_iterator cell =
+				_visitedCells.find(visitedCellKey(cx, cy));
+			if (cell == _visitedCells.end())
+				continue;
+
+			Common::Array<uint>::const_iterator iter;
+			for (iter = cell->_value.begin(); iter != cell->_value.end(); iter++) {
+				if (_visited[*iter].checkPoint(pt, 8*8))
+					return true;
+			}
+		}
 	}
 
 	return false;
 }
 
+void Pathfinder::addVisited(const PathfindingState &state) {
+	_visitedCells[visitedCellKey(state._point.x, state._point.y)].push_back(_visited.size());
+	_visited.push_back(state);
+}
+
+FailedPathSearch Pathfinder::getSearch() const {
+	const ObjId targetId = _targetItem ? _targetItem->getObjId() : 0;
+	return FailedPathSearch(_actor->getObjId(), targetId, _hitMode, false, _start._point, _target);
+}
+
 bool Pathfinder::checkTarget(const PathNode *node) const {
 	// TODO: these ranges are probably a bit too high,
 	// but otherwise it won't work properly yet -wjp
@@ -411,7 +439,8 @@ void Pathfinder::expandNode(PathNode *node) {
 	Animation::Sequence walkanim = Animation::walk;
 	PathfindingState state, closeststate;
 	AnimationTracker tracker;
-	expandednodes++;
+	_expandedNodes++;
+	totalexpandednodes++;
 
 	if (_actor->isInCombat())
 		walkanim = Animation::advance;
@@ -476,19 +505,19 @@ void Pathfinder::expandNode(PathNode *node) {
 			tracker.updateState(state);
 			if (!alreadyVisited(state._point)) {
 				newNode(node, state, 0);
-				_visited.push_back(state);
+				addVisited(state);
 			}
 		} else {
 			// an obstruction was encountered, so generate a visited node to block
 			// future evaluation at the endpoint.
-			_visited.push_back(state);
+			addVisited(state);
 		}
 
 		// TODO: maybe only allow partial steps close to target?
 		if (beststeps != 0 && (beststeps != steps ||
 		                       (!tracker.isDone() && _targetItem))) {
 			newNode(node, closeststate, beststeps);
-			_visited.push_back(closeststate);
+			addVisited(closeststate);
 		}
 	}
 }
@@ -517,6 +546,15 @@ bool Pathfinder::pathfind(Std::vector<PathfindingAction> &path) {
 
 	path.clear();
 
+	CurrentMap *map = World::get_instance()->getCurrentMap();
+	if (map->hasPathRecentlyFailed(getSearch())) {
+		debugC(kDebugPath, "Pathfinder: same search failed recently, not retrying");
+		failurecachehits++;
+		return false;
+	}
+
+	totalsearches++;
+
 	PathNode *startnode = new PathNode();
 	startnode->state = _start;
 	startnode->cost = 0;
@@ -604,6 +642,7 @@ bool Pathfinder::pathfind(Std::vector<PathfindingAction> &path) {
 	pftotaltime += _expandTime;
 	debugC(kDebugPath, "maxout average = %dms.", pftotaltime / pfcalls);
 
+	map->addFailedPath(getSearch());
 	return false;
 }
 
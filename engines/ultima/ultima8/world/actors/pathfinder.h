@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_WORLD_ACTORS_PATHFINDER_H
 #define ULTIMA8_WORLD_ACTORS_PATHFINDER_H
 
+#include "common/hashmap.h"
 #include "ultima/shared/std/containers.h"
 #include "ultima/ultima8/misc/direction.h"
 #include "ultima/ultima8/misc/point3.h"
@@ -34,6 +35,7 @@ namespace Ultima8 {
 
 class Actor;
 class Item;
+struct FailedPathSearch;
 
 struct PathfindingState {
 	PathfindingState() : _point(), _direction(dir_north),
@@ -96,12 +98,19 @@ protected:
 	int32 _actorXd, _actorYd, _actorZd;
 
 	Common::Array<PathfindingState> _visited;
+
+	/** Indices into _visited, bucketed by coarse xy cell to speed up alreadyVisited */
+	Common::HashMap<uint32, Common::Array<uint>> _visitedCells;
+
+	unsigned int _expandedNodes;
 	Std::priority_queue<PathNode *, Std::vector<PathNode *>, PathNodeCmp> _nodes;
 
 	/** List of nodes for garbage collection later and order is not important */
 	Std::vector<PathNode *> _cleanupNodes;
 
 	bool alreadyVisited(const Point3 &pt) const;
+	void addVisited(const PathfindingState &state);
+	FailedPathSearch getSearch() const;
 	void newNode(PathNode *oldnode, PathfindingState &state,
 				 unsigned int steps);
 	void expandNode(PathNode *node);
@@ -51,8 +51,12 @@ typedef Std::list<Item *> item_list;
 const int INT_MAX_VALUE = 0x7fffffff;
 const int INT_MIN_VALUE = -INT_MAX_VALUE - 1;
 
+// How long a failed path search is remembered, half a second
+static const uint32 FAILED_PATH_TICKS = Kernel::TICKS_PER_SECOND / 2;
+
 CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
-	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1) {
+	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1),
+	  _numFailedPaths(0), _lastFailedPath(0) {
 	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
@@ -88,6 +92,7 @@ void CurrentMap::clear() {
 
 	_fastXMin =  _fastYMin = _fastXMax = _fastYMax = -1;
 	_currentMap = nullptr;
+	clearFailedPaths();
 
 	Process *ehp = Kernel::get_instance()->getProcess(_eggHatcher);
 	if (ehp)
@@ -202,6 +207,8 @@ void CurrentMap::loadMap(Map *map) {
 		_targets[i] = 0;
 	}
 
+	clearFailedPaths();
+
 	loadItems(map->_fixedItems, callCacheIn);
 	loadItems(map->_dynamicItems, callCacheIn);
 
@@ -258,6 +265,7 @@ void CurrentMap::addItem(Item *item) {
 
 	_items[cx][cy].push_front(item);
 	item->setExtFlag(Item::EXT_INCURMAP);
+	clearFailedPaths();
 
 	Egg *egg = dynamic_cast<Egg *>(item);
 	if (egg) {
@@ -295,6 +303,7 @@ void CurrentMap::addItemToEnd(Item *item) {
 
 	_items[cx][cy].push_back(item);
 	item->setExtFlag(Item::EXT_INCURMAP);
+	clearFailedPaths();
 
 	Egg *egg = dynamic_cast<Egg *>(item);
 	if (egg) {
@@ -406,6 +415,34 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 
 	_items[cx][cy].remove(item);
 	item->clearExtFlag(Item::EXT_INCURMAP);
+	clearFailedPaths();
+}
+
+bool CurrentMap::hasPathRecentlyFailed(const FailedPathSearch &search) const {
+	const uint32 now = Kernel::get_instance()->getTickNum();
+
+	for (unsigned int i = 0; i < _numFailedPaths; i++) {
+		const FailedPathSearch &f = _failedPaths[i];
+		if (now - f._tick > FAILED_PATH_TICKS)
+			continue;
+		if (f._actor == search._actor && f._targetItem == search._targetItem &&
+		        f._hitMode == search._hitMode && f._direct == search._direct &&
+		        f._start == search._start && f._target == search._target)
+			return true;
+	}
+
+	return false;
+}
+
+void CurrentMap::addFailedPath(const FailedPathSearch &search) {
+	if (_numFailedPaths < MAP_NUM_FAILED_PATHS) {
+		_lastFailedPath = _numFailedPaths++;
+	} else {
+		_lastFailedPath = (_lastFailedPath + 1) % MAP_NUM_FAILED_PATHS;
+	}
+
+	_failedPaths[_lastFailedPath] = search;
+	_failedPaths[_lastFailedPath]._tick = Kernel::get_instance()->getTickNum();
 }
 
 // Check to see if the chunk is on the screen
@@ -1262,6 +1299,9 @@ bool CurrentMap::load(Common::ReadStream *rs, uint32 version) {
 	_fastXMax = -1;
 	_fastYMax = -1;
 
+	// The tick counter restarts when loading
+	clearFailedPaths();
+
 	if (GAME_IS_CRUSADER) {
 		for (int i = 0; i < MAP_NUM_TARGET_ITEMS; i++)
 			_targets[i] = rs->readUint16LE();
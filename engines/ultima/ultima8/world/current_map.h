@@ -40,6 +40,22 @@ class EggHatcherProcess;
 
 #define MAP_NUM_CHUNKS  64
 #define MAP_NUM_TARGET_ITEMS 200
+#define MAP_NUM_FAILED_PATHS 16
+
+//! A path search which failed, see CurrentMap::hasPathRecentlyFailed()
+struct FailedPathSearch {
+	FailedPathSearch() : _actor(0), _targetItem(0), _hitMode(false), _direct(false), _tick(0) {}
+	FailedPathSearch(ObjId actor, ObjId targetItem, bool hitMode, bool direct, const Point3 &start, const Point3 &target) :
+		_actor(actor), _targetItem(targetItem), _hitMode(hitMode), _direct(direct), _start(start), _target(target), _tick(0) {}
+
+	ObjId _actor;
+	ObjId _targetItem;
+	bool _hitMode;
+	bool _direct; //!< Only walking towards the target, as CruPathfinderProcess does
+	Point3 _start;
+	Point3 _target;
+	uint32 _tick;
+};
 
 class CurrentMap {
 	friend class World;
@@ -83,6 +99,17 @@ public:
 	//! Update the fast area for the cameras position
 	void updateFastArea(const Point3 &from, const Point3 &to);
 
+	//! Check whether an identical path search failed recently. Actors
+	//! (e.g. in combat) often retry a search for an unreachable target
+	//! right away, and a failed search is the most expensive kind.
+	bool hasPathRecentlyFailed(const FailedPathSearch &search) const;
+	//! Remember a failed path search, until the map or an item in it changes
+	void addFailedPath(const FailedPathSearch &search);
+	//! Forget all failed path searches, called when items move or change
+	void clearFailedPaths() {
+		_numFailedPaths = 0;
+	}
+
 	//! search an area for items matching a loopscript
 	//! \param itemlist the list to return objids in
 	//! \param loopscript the script to check items against
@@ -217,6 +244,12 @@ private:
 	//! this in a more fancy data structure, but this works fine.
 	ObjId _targets[MAP_NUM_TARGET_ITEMS];
 
+	//! Recently failed path searches. Once all of them are used, the one
+	//! after _lastFailedPath is replaced next.
+	FailedPathSearch _failedPaths[MAP_NUM_FAILED_PATHS];
+	unsigned int _numFailedPaths;
+	unsigned int _lastFailedPath;
+
 	void setChunkFast(int32 cx, int32 cy);
 	void unsetChunkFast(int32 cx, int32 cy);
 };
@@ -223,6 +223,9 @@ void Item::move(int32 X, int32 Y, int32 Z) {
 			map->addItemToEnd(this);
 		else
 			map->addItem(this);
+	} else {
+		// Paths around the item may have changed
+		map->clearFailedPaths();
 	}
 
 	// Call just moved
@@ -502,6 +505,10 @@ void Item::setShape(uint32 shape) {
 		_shape = shape;
 		_cachedShapeInfo = nullptr;
 	}
+
+	// The new shape may block different paths
+	if (_extendedFlags & EXT_INCURMAP)
+		World::get_instance()->getCurrentMap()->clearFailedPaths();
 }
 
 bool Item::overlaps(const Item &item2) const {
@@ -45,10 +45,14 @@ namespace Ultima8 {
 static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
+// Size in pixels of a cell of the screenspace overlap grid
+static const int32 GRID_CELL_SIZE = 64;
+
 ItemSorter::ItemSorter(int capacity) :
 	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
 	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
+	_sortLimit(0), _sortLimitChanged(false), _gridCols(0), _gridRows(0),
+	_addCount(0), _stamp(0) {
 	int i = capacity;
 	while (i--) {
 		SortItem *next = _itemsUnused;
@@ -88,6 +92,17 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 	_itemsTail = nullptr;
 	_painted = nullptr;
 
+	// Reset the overlap grid. Cell arrays keep their storage between frames.
+	_gridCols = MAX<int32>((clipWindow.width() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE, 1);
+	_gridRows = MAX<int32>((clipWindow.height() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE, 1);
+	if (_grid.size() < (uint)(_gridCols * _gridRows))
+		_grid.resize(_gridCols * _gridRows);
+	for (uint i = 0; i < _grid.size(); i++)
+		_grid[i].resize(0);
+
+	_groupTails.resize(0);
+	_addCount = 0;
+
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	int32 camSx = (cam.x - cam.y) / 4;
 	// Screenspace bounding box bottom extent  (RNB y coord)
@@ -187,17 +202,38 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	si->_seq = _addCount++;
+
+	// Collect the items sharing a grid cell with us. Only those can overlap,
+	// since overlap() requires the shape rects to intersect. Occluded items
+	// are skipped, as they take no further part in sorting.
+	int32 cx0, cy0, cx1, cy1;
+	getGridCells(si->_sr, cx0, cy0, cx1, cy1);
+
+	_stamp++;
+	_candidates.resize(0);
+	for (int32 cy = cy0; cy <= cy1; cy++) {
+		for (int32 cx = cx0; cx <= cx1; cx++) {
+			const Std::vector<SortItem *> &cell = _grid[cy * _gridCols + cx];
+			for (uint i = 0; i < cell.size(); i++) {
+				SortItem *si2 = cell[i];
+				if (si2->_stamp != _stamp) {
+					si2->_stamp = _stamp;
+					if (!si2->_occluded)
+						_candidates.push_back(si2);
+				}
+			}
+		}
+	}
 
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
+	// Compare in list order, so dependency lists are built the same way as
+	// walking the whole list would
+	Common::sort(_candidates.begin(), _candidates.end(), [](const SortItem *a, const SortItem *b) {
+		return a->listBefore(*b);
+	});
 
-		if (si2->_occluded)
-			continue;
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
 
 #ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
 		// Find adjoining rects for better occlusion
@@ -245,9 +281,48 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 
 	// Add it to the list
 	_itemsUnused = _itemsUnused->_next;
+	insertSorted(si);
+
+	// Occluded items are never candidates, so only visible ones go in the grid
+	if (!si->_occluded) {
+		for (int32 cy = cy0; cy <= cy1; cy++) {
+			for (int32 cx = cx0; cx <= cx1; cx++)
+				_grid[cy * _gridCols + cx].push_back(si);
+		}
+	}
+}
+
+void ItemSorter::getGridCells(const Rect &r, int32 &cx0, int32 &cy0, int32 &cx1, int32 &cy1) const {
+	// Rects partly outside the clip window are clamped into the edge cells
+	cx0 = CLIP<int32>((r.left - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridCols - 1);
+	cy0 = CLIP<int32>((r.top - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridRows - 1);
+	cx1 = CLIP<int32>((r.right - 1 - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridCols - 1);
+	cy1 = CLIP<int32>((r.bottom - 1 - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridRows - 1);
+}
+
+void ItemSorter::insertSorted(SortItem *si) {
+	// Find the first group that comes after us
+	uint lo = 0;
+	uint hi = _groupTails.size();
+	while (lo < hi) {
+		uint mid = (lo + hi) / 2;
+		if (si->listLessThan(*_groupTails[mid]))
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	// Our insert point is before the first item that has higher z than us
+	SortItem *addpoint;
+	if (lo > 0 && !_groupTails[lo - 1]->listLessThan(*si)) {
+		// Join the end of an existing group
+		addpoint = _groupTails[lo - 1]->_next;
+		_groupTails[lo - 1] = si;
+	} else {
+		addpoint = lo > 0 ? _groupTails[lo - 1]->_next : _items;
+		_groupTails.insert_at(lo, si);
+	}
 
-	// have a position
-	//addpoint = 0;
 	if (addpoint) {
 		si->_next = addpoint;
 		si->_prev = addpoint->_prev;
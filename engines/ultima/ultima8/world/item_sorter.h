@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "ultima/shared/std/containers.h"
 #include "ultima/ultima8/misc/rect.h"
 
 namespace Ultima {
@@ -46,6 +47,20 @@ class ItemSorter {
 	int32       _sortLimit;
 	bool        _sortLimitChanged;
 
+	// Screenspace grid over the clip window. Each cell lists the visible items
+	// whose shape rect touches it, so AddItem only has to compare a new item
+	// against its neighbours rather than the whole list.
+	Std::vector<Std::vector<SortItem *> > _grid;
+	int32       _gridCols, _gridRows;
+
+	// Last item of each run of items that are equal under listLessThan, in list
+	// order. Used to find where a new item goes without walking the list.
+	Std::vector<SortItem *> _groupTails;
+
+	Std::vector<SortItem *> _candidates;
+	uint32      _addCount;
+	uint32      _stamp;
+
 public:
 	ItemSorter(int capacity);
 	~ItemSorter();
@@ -71,6 +86,12 @@ public:
 
 private:
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad);
+
+	// Get the range of grid cells touched by a screenspace rect
+	void getGridCells(const Rect &r, int32 &cx0, int32 &cy0, int32 &cx1, int32 &cy1) const;
+
+	// Link an item into the sorted list and the group index
+	void insertSorted(SortItem *si);
 };
 
 } // End of namespace Ultima8
@@ -50,7 +50,7 @@ struct SortItem {
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
 			_land(false), _occluded(false), _sprite(false),
-			_invitem(false) { }
+			_invitem(false), _seq(0), _stamp(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -120,6 +120,9 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	uint32  _seq;        // Order in which the item was added to the display list
+	uint32  _stamp;      // Last ItemSorter::AddItem call that found this as an overlap candidate
+
 	// Note that Std::priority_queue could be used here, BUT there is no guarentee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Std::list, BUT there is no guarentee that it will keep wont delete
@@ -263,6 +266,16 @@ struct SortItem {
 		return si1._flat > si2._flat;
 	}
 
+	// Comparison giving the exact order of the sorted lists. Items that are equal
+	// under listLessThan stay in the order they were added.
+	inline bool listBefore(const SortItem &si2) const {
+		if (listLessThan(si2))
+			return true;
+		if (si2.listLessThan(*this))
+			return false;
+		return _seq < si2._seq;
+	}
+
 	Common::String dumpInfo() const;
 };
 
@@ -49,9 +49,9 @@ XMeshOpenGL::~XMeshOpenGL() {
 //////////////////////////////////////////////////////////////////////////
 bool XMeshOpenGL::render(XModel *model) {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
-	auto indexData = _skinMesh->_mesh->_indexData;
-	auto indexRanges = _skinMesh->_mesh->_indexRanges;
-	auto materialIndices = _skinMesh->_mesh->_materialIndices;
+	const auto &indexData = _skinMesh->_mesh->_indexData;
+	const auto &indexRanges = _skinMesh->_mesh->_indexRanges;
+	const auto &materialIndices = _skinMesh->_mesh->_materialIndices;
 	if (vertexData == nullptr) {
 		return false;
 	}
@@ -53,7 +53,7 @@ XMeshOpenGLShader::~XMeshOpenGLShader() {
 
 bool XMeshOpenGLShader::loadFromXData(const Common::String &filename, XFileData *xobj, Common::Array<MaterialReference> &materialReferences) {
 	if (XMesh::loadFromXData(filename, xobj, materialReferences)) {
-		auto indexData = _skinMesh->_mesh->_indexData;
+		const auto &indexData = _skinMesh->_mesh->_indexData;
 		float *vertexData = _skinMesh->_mesh->_vertexData;
 		uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
 
@@ -72,8 +72,8 @@ bool XMeshOpenGLShader::loadFromXData(const Common::String &filename, XFileData
 //////////////////////////////////////////////////////////////////////////
 bool XMeshOpenGLShader::render(XModel *model) {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
-	auto indexRanges = _skinMesh->_mesh->_indexRanges;
-	auto materialIndices = _skinMesh->_mesh->_materialIndices;
+	const auto &indexRanges = _skinMesh->_mesh->_indexRanges;
+	const auto &materialIndices = _skinMesh->_mesh->_materialIndices;
 	if (vertexData == nullptr) {
 		return false;
 	}
@@ -117,7 +117,7 @@ bool XMeshOpenGLShader::render(XModel *model) {
 
 bool XMeshOpenGLShader::renderFlatShadowModel() {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
-	auto indexRanges = _skinMesh->_mesh->_indexRanges;
+	const auto &indexRanges = _skinMesh->_mesh->_indexRanges;
 	if (vertexData == nullptr) {
 		return false;
 	}
@@ -33,6 +33,7 @@
 #include "engines/wintermute/math/math_util.h"
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_sprite.h"
+#include "engines/wintermute/base/font/base_font.h"
 #include "engines/util.h"
 
 #include "common/system.h"
@@ -57,7 +58,7 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
+	_redrawnPixels = _redrawnRects = 0;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -75,8 +76,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -158,8 +157,7 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -198,9 +196,7 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -381,13 +377,47 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 	}
 }
 
+// More dirty rects than this are collapsed into their bounding box, as
+// every rect costs a pass over the render queue.
+static const uint kMaxDirtyRects = 16;
+
+static int rectArea(const Common::Rect &rect) {
+	return rect.width() * rect.height();
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect newRect(rect);
+	newRect.clip(_renderRect);
+	if (newRect.isEmpty()) {
+		return;
+	}
+
+	// Merge with every rect that overlaps, or that is close enough that
+	// the combined rect adds no more than a quarter of unchanged area.
+	// Merging can grow the rect into others, so restart after each merge.
+	uint i = 0;
+	while (i < _dirtyRects.size()) {
+		const Common::Rect &other = _dirtyRects[i];
+		Common::Rect merged(newRect);
+		merged.extend(other);
+		if (newRect.intersects(other) || rectArea(merged) * 4 <= (rectArea(newRect) + rectArea(other)) * 5) {
+			newRect = merged;
+			_dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+	_dirtyRects.push_back(newRect);
+
+	if (_dirtyRects.size() > kMaxDirtyRects) {
+		Common::Rect bounds(_dirtyRects[0]);
+		for (i = 1; i < _dirtyRects.size(); i++) {
+			bounds.extend(_dirtyRects[i]);
+		}
+		_dirtyRects.clear();
+		_dirtyRects.push_back(bounds);
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -406,7 +436,7 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -416,29 +446,66 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
-	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
-	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
-	// the background color. Typical use-case: Fullscreen FMVs.
-	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+	_redrawnPixels = 0;
+	_redrawnRects = _dirtyRects.size();
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		const Common::Rect &dirtyRect = _dirtyRects[i];
+		drawDirtyRect(dirtyRect);
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
+		_redrawnPixels += rectArea(dirtyRect);
+	}
+
+	// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		(*it)->_wantsDraw = false;
+	}
+
+	it = _renderQueue.begin();
+	// Clean out the old tickets
+	while (it != _renderQueue.end()) {
+		if ((*it)->_isValid == false) {
+			RenderTicket *ticket = *it;
+			addDirtyRect((*it)->_dstRect);
+			it = _renderQueue.erase(it);
+			delete ticket;
+		} else {
+			++it;
 		}
-		// Otherwise Do NOT fill.
-	} else {
+	}
+
+}
+
+void BaseRenderOSystem::drawDirtyRect(const Common::Rect &dirtyRect) {
+	// Anything below an opaque ticket that covers the whole dirty rect is
+	// hidden, so start drawing from the last such ticket and skip filling
+	// with the clear-color. Typical use-case: Fullscreen FMVs and backgrounds.
+	RenderQueueIterator first = _renderQueue.begin();
+	bool covered = false;
+	RenderQueueIterator it;
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		const RenderTicket *ticket = *it;
+		if (ticket->_owner && ticket->_transform._alphaDisable && ticket->_transform._angle == 0 &&
+		    ticket->_transform._rgbaMod == Graphics::kDefaultRgbaMod &&
+		    ticket->_transform._blendMode == Graphics::BLEND_NORMAL &&
+		    ticket->_dstRect.contains(dirtyRect)) {
+			first = it;
+			covered = true;
+		}
+	}
+
+	if (!covered) {
 		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		_renderSurface->fillRect(dirtyRect, _clearColor);
 	}
-	for (; it != _renderQueue.end(); ++it) {
+
+	for (it = first; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
+		if (ticket->_dstRect.intersects(dirtyRect)) {
 			// dstClip is the area we want redrawn.
 			Common::Rect dstClip(ticket->_dstRect);
 			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
+			dstClip.clip(dirtyRect);
 			// we need to keep track of the position to redraw the dirty rect
 			Common::Rect pos(dstClip);
 			int16 offsetX = ticket->_dstRect.left;
@@ -449,24 +516,7 @@ void BaseRenderOSystem::drawTickets() {
 			drawFromSurface(ticket, &pos, &dstClip);
 			_needsFlip = true;
 		}
-		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
-		ticket->_wantsDraw = false;
-	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-
-	it = _renderQueue.begin();
-	// Clean out the old tickets
-	while (it != _renderQueue.end()) {
-		if ((*it)->_isValid == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
-		} else {
-			++it;
-		}
 	}
-
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -523,6 +573,18 @@ Common::String BaseRenderOSystem::getName() const {
 	return "ScummVM-OSystem-renderer";
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool BaseRenderOSystem::displayDebugInfo() {
+	if (_disableDirtyRects || !_gameRef->getSystemFont()) {
+		return STATUS_FAILED;
+	}
+
+	int percent = (int)((uint64)_redrawnPixels * 100 / MAX(1, rectArea(_renderRect)));
+	Common::String str = Common::String::format("Redrawn: %u px, %u rects (%d%%)", _redrawnPixels, _redrawnRects, percent);
+	_gameRef->getSystemFont()->drawText((const byte *)str.c_str(), 0, 90, getWidth(), TAL_RIGHT);
+	return STATUS_OK;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool BaseRenderOSystem::setViewport(int left, int top, int right, int bottom) {
 	Common::Rect rect;
@@ -32,6 +32,7 @@
 
 #include "common/rect.h"
 #include "common/list.h"
+#include "common/array.h"
 
 #include "graphics/surface.h"
 #include "graphics/transform_struct.h"
@@ -66,6 +67,7 @@ public:
 	typedef Common::List<RenderTicket *>::iterator RenderQueueIterator;
 
 	Common::String getName() const override;
+	bool displayDebugInfo() override;
 
 	bool initRenderer(int width, int height, bool windowed) override;
 	bool flip() override;
@@ -119,6 +121,8 @@ public:
 private:
 	/**
 	 * Mark a specified rect of the screen as dirty.
+	 * The rect is merged with any existing dirty rects it overlaps, or that
+	 * it can be combined with without redrawing too much unchanged area.
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
@@ -126,11 +130,18 @@ private:
 	 * Traverse the tickets that are dirty, and draw them
 	 */
 	void drawTickets();
+	/**
+	 * Redraw the tickets that intersect one dirty rect, starting from the
+	 * topmost opaque ticket that covers all of it.
+	 */
+	void drawDirtyRect(const Common::Rect &dirtyRect);
 	// Non-dirty-rects:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Array<Common::Rect> _dirtyRects;
+	uint32 _redrawnPixels; // statistics for the last drawn frame
+	uint32 _redrawnRects;
 	Common::List<RenderTicket *> _renderQueue;
 
 	bool _needsFlip;
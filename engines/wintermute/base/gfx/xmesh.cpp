@@ -80,7 +80,7 @@ bool XMesh::findBones(FrameNode *rootFrame) {
 	if (!_skinnedMesh) {
 		return true;
 	}
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	const auto &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
 
 	_boneMatrices.resize(skinWeightsList.size());
 
@@ -107,68 +107,41 @@ bool XMesh::update(FrameNode *parentFrame) {
 	float *vertexPositionData = _skinMesh->_mesh->_vertexPositionData;
 	float *vertexNormalData = _skinMesh->_mesh->_vertexNormalData;
 	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	const BaseArray<SkinWeights> &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
 
 	// update skinned mesh
 	if (_skinnedMesh) {
-		BaseArray<Math::Matrix4> finalBoneMatrices;
-		finalBoneMatrices.resize(_boneMatrices.size());
-
-		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i] = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
-		}
-
 		// the new vertex coordinates are the weighted sum of the product
 		// of the combined bone transformation matrices and the static pose coordinates
 		// to be able too add the weighted summands together, we reset everything to zero first
 		for (uint32 i = 0; i < vertexCount; ++i) {
+			float *vertex = vertexData + i * XSkinMeshLoader::kVertexComponentCount;
 			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] = 0.0f;
+				vertex[XSkinMeshLoader::kPositionOffset + j] = 0.0f;
+				vertex[XSkinMeshLoader::kNormalOffset + j] = 0.0f;
 			}
 		}
 
 		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
+			const SkinWeights &skinWeights = skinWeightsList[boneIndex];
+			Math::Matrix4 boneMatrix = *_boneMatrices[boneIndex] * skinWeights._offsetMatrix;
+
+			// normals are transformed by the inverse transpose of the bone transformation
+			Math::Matrix4 normalMatrix = boneMatrix;
+			normalMatrix.transpose();
+			normalMatrix.inverse();
+
 			// to every vertex which is affected by the bone, we add the product
 			// of the bone transformation with the coordinates of the static pose,
 			// weighted by the weight for the particular vertex
 			// repeating this procedure for all bones gives the new pose
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexPositionData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] += pos.getData()[j];
-				}
-			}
-		}
+			for (uint i = 0; i < skinWeights._vertexIndices.size(); ++i) {
+				uint32 vertexIndex = skinWeights._vertexIndices[i];
+				float weight = skinWeights._vertexWeights[i];
+				float *vertex = vertexData + vertexIndex * XSkinMeshLoader::kVertexComponentCount;
 
-		// now we have to update the vertex normals as well, so prepare the bone transformations
-		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i].transpose();
-			finalBoneMatrices[i].inverse();
-		}
-
-		// reset so we can form the weighted sums
-		for (uint32 i = 0; i < vertexCount; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] = 0.0f;
-			}
-		}
-
-		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexNormalData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] += pos.getData()[j];
-				}
+				boneMatrix.transformAdd(vertex + XSkinMeshLoader::kPositionOffset, vertexPositionData + vertexIndex * 3, weight, true);
+				normalMatrix.transformAdd(vertex + XSkinMeshLoader::kNormalOffset, vertexNormalData + vertexIndex * 3, weight, true);
 			}
 		}
 
@@ -203,7 +176,7 @@ bool XMesh::updateShadowVol(ShadowVolume *shadow, Math::Matrix4 &modelMat, const
 
 	uint32 numEdges = 0;
 
-	auto indexData = _skinMesh->_mesh->_indexData;
+	const auto &indexData = _skinMesh->_mesh->_indexData;
 	Common::Array<bool> isFront(indexData.size() / 3, false);
 
 	// First pass : for each face, record if it is front or back facing the light
@@ -288,7 +261,7 @@ bool XMesh::pickPoly(Math::Vector3d *pickRayOrig, Math::Vector3d *pickRayDir) {
 
 	bool res = false;
 
-	auto indexData = _skinMesh->_mesh->_indexData;
+	const auto &indexData = _skinMesh->_mesh->_indexData;
 	for (uint16 i = 0; i < indexData.size(); i += 3) {
 		uint16 index1 = indexData[i + 0];
 		uint16 index2 = indexData[i + 1];
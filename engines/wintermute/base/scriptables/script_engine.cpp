@@ -33,6 +33,7 @@
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/utils/utils.h"
+#include "common/tracing.h"
 
 namespace Wintermute {
 
@@ -271,6 +272,8 @@ byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ig
 
 //////////////////////////////////////////////////////////////////////////
 bool ScEngine::tick() {
+	TRACE_ZONE("Wintermute::ScEngine::tick");
+
 	if (_scripts.size() == 0) {
 		return STATUS_OK;
 	}
@@ -494,6 +494,32 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Applies the state changes of a draw step (colors, fill mode, clipping
+	 * rect...) without drawing anything. This is the first half of drawStep(),
+	 * and leaves the renderer as if the step had been drawn.
+	 */
+	void applyStepState(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
+
+	/**
+	 * Colors that persist from one draw step to the next. Steps which don't
+	 * set a color themselves draw with the one left by the previous step.
+	 */
+	struct ColorState {
+		uint32 fg, bg, bevel;
+		uint32 gradientStart, gradientEnd;
+
+		bool operator==(const ColorState &other) const {
+			return fg == other.fg && bg == other.bg && bevel == other.bevel &&
+			       gradientStart == other.gradientStart && gradientEnd == other.gradientEnd;
+		}
+	};
+
+	/**
+	 * Returns the colors the next draw step will inherit.
+	 */
+	virtual ColorState getColorState() const = 0;
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
@@ -83,6 +83,11 @@ public:
 	void setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) override;
 	void setClippingRect(const Common::Rect &clippingArea) override { _clippingArea = clippingArea; }
 
+	ColorState getColorState() const override {
+		ColorState state = { _fgColor, _bgColor, _bevelColor, _gradientStart, _gradientEnd };
+		return state;
+	}
+
 	void copyFrame(OSystem *sys, const Common::Rect &r) override;
 	void copyWholeFrame(OSystem *sys) override { copyFrame(sys, Common::Rect(0, 0, _activeSurface->w, _activeSurface->h)); }
 
@@ -38,6 +38,7 @@
 #include "common/stream.h"
 #include "common/memstream.h"
 #include "common/hashmap.h"
+#include "common/md5.h"
 #include "common/ptr.h"
 #include "common/compression/unzip.h"
 
@@ -89,6 +90,8 @@ inline int divRoundToNearest(int dividend, int divisor) {
 
 } // End of anonymous namespace
 
+class TTFFace;
+
 class TTFLibrary : public Common::Singleton<TTFLibrary> {
 public:
 	TTFLibrary();
@@ -101,9 +104,30 @@ public:
 
 	bool loadFont(const uint8 *file, const int32 face_index, const uint32 size, FT_Face &face);
 	void closeFont(FT_Face &face);
+
+	/**
+	 * Return the face loaded with the given key, see TTFFace, with its
+	 * reference count increased. Returns nullptr if there is none.
+	 */
+	TTFFace *acquireFace(const Common::String &key);
+
+	/**
+	 * Make a newly loaded face, with a reference count of one, available
+	 * to acquireFace.
+	 */
+	void registerFace(TTFFace *face);
+
+	/**
+	 * Decrease the reference count of a face, and destroy it once it is
+	 * no longer used.
+	 */
+	void releaseFace(TTFFace *face);
 private:
 	FT_Library _library;
 	bool _initialized;
+
+	typedef Common::HashMap<Common::String, TTFFace *> FaceMap;
+	FaceMap _faces;
 };
 
 void shutdownTTF() {
@@ -136,61 +160,74 @@ void TTFLibrary::closeFont(FT_Face &face) {
 	FT_Done_Face(face);
 }
 
-class TTFFont : public Font {
+/**
+ * A face loaded at one size with one set of rendering options, together
+ * with the glyphs and kerning pairs cached for it.
+ *
+ * All TTFFont instances loading the same face with the same options share
+ * one TTFFace through TTFLibrary, so the font file, the FreeType face and
+ * the rendered glyphs exist only once. Glyphs are keyed by code point.
+ */
+class TTFFace {
 public:
-	TTFFont();
-	~TTFFont() override;
-
-	bool load(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode,
-	          uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening);
-	bool load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool fakeBold, bool fakeItalic,
-	          int size, TTFSizeMode sizeMode, uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening);
+	struct Glyph {
+		Surface image;
+		int xOffset, yOffset;
+		int advance;
+		FT_UInt slot;
+	};
 
-	int getFontHeight() const override;
-	Common::String getFontName() const override;
-	int getFontAscent() const override;
+	/**
+	 * @param key      Identifies the face and options, see TTFFont::load.
+	 * @param face     The FreeType face, owned by this object.
+	 * @param ttfFile  The font file data of the face, owned by this object.
+	 */
+	TTFFace(const Common::String &key, FT_Face face, uint8 *ttfFile);
+	~TTFFace();
 
-	int getMaxCharWidth() const override;
+	bool setup(int pointSize, uint xdpi, uint ydpi, TTFRenderMode renderMode, bool fakeBold, bool fakeItalic, bool stemDarkening);
 
-	int getCharWidth(uint32 chr) const override;
+	/**
+	 * Return the glyph for a code point, rendering it first if it is not
+	 * cached yet and allowCaching is set.
+	 */
+	const Glyph *findGlyph(uint32 chr, bool allowCaching);
 
-	int getKerningOffset(uint32 left, uint32 right) const override;
+	int getKerningOffset(FT_UInt leftGlyph, FT_UInt rightGlyph);
 
-	Common::Rect getBoundingBox(uint32 chr) const override;
+	/**
+	 * Do not delete the font file on destruction, for when loading a font
+	 * fails and the caller keeps ownership of it.
+	 */
+	void releaseFile() { _ttfFile = nullptr; }
 
-	void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const override;
-	void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const override;
+	const Common::String &getKey() const { return _key; }
+	const char *getFamilyName() const { return _face->family_name; }
+	int getHeight() const { return _height; }
+	int getAscent() const { return _ascent; }
+	int getMaxCharWidth() const { return _width; }
+	bool hasKerning() const { return _hasKerning; }
 
 private:
-	bool _initialized;
-	FT_Face _face;
+	friend class TTFLibrary;
 
+	bool cacheGlyph(Glyph &glyph, uint32 chr);
+
+	uint _refCount;
+	const Common::String _key;
+	FT_Face _face;
 	uint8 *_ttfFile;
-	uint32 _size;
 
 	int _width, _height;
 	int _ascent, _descent;
 
-	struct Glyph {
-		Surface image;
-		int xOffset, yOffset;
-		int advance;
-		FT_UInt slot;
-	};
-
-	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
-	mutable GlyphCache _glyphs;
-	bool _allowLateCaching;
-	void assureCached(uint32 chr) const;
-
-	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
+	GlyphCache _glyphs;
 
-	int computePointSize(int size, TTFSizeMode sizeMode) const;
-	int readPointSizeFromVDMXTable(int height) const;
-	int computePointSizeFromHeaders(int height) const;
-	void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color,
-		const uint32 *transparentColor) const;
+	// Kerning offsets keyed by (left slot << 16) | right slot. TrueType
+	// glyph indices are 16 bit, so the key is unique for every pair.
+	typedef Common::HashMap<uint32, int> KerningCache;
+	KerningCache _kerningPairs;
 
 	FT_Int32 _loadFlags;
 	FT_Render_Mode _renderMode;
@@ -200,95 +237,46 @@ private:
 	bool _fakeItalic;
 };
 
-TTFFont::TTFFont()
-	: _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-	  _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
-	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false) {
-}
-
-TTFFont::~TTFFont() {
-	if (_initialized) {
-		g_ttf.closeFont(_face);
-
-		delete[] _ttfFile;
-		_ttfFile = 0;
-
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
+TTFFace *TTFLibrary::acquireFace(const Common::String &key) {
+	FaceMap::iterator i = _faces.find(key);
+	if (i == _faces.end())
+		return nullptr;
 
-		_initialized = false;
-	}
+	i->_value->_refCount++;
+	return i->_value;
 }
 
-bool TTFFont::load(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode,
-				   uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
-	if (!g_ttf.isInitialized())
-		return false;
-
-	uint32 sizeFile = stream.size();
-	if (!sizeFile)
-		return false;
-
-	uint8 *ttfFile = new uint8[sizeFile];
-	assert(ttfFile);
-
-	if (stream.read(ttfFile, sizeFile) != sizeFile) {
-		delete[] ttfFile;
-		return false;
-	}
-
-	if (!load(ttfFile, sizeFile, 0, false, false, size, sizeMode, xdpi, ydpi, renderMode, mapping, stemDarkening)) {
-		delete[] ttfFile;
-		return false;
-	}
-
-	// Don't delete ttfFile as it's now owned by the class
-	return true;
+void TTFLibrary::registerFace(TTFFace *face) {
+	assert(!_faces.contains(face->getKey()));
+	_faces[face->getKey()] = face;
 }
 
-bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold, bool italic,
-				   int size, TTFSizeMode sizeMode, uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
-	_initialized = false;
-
-	if (!g_ttf.isInitialized())
-		return false;
-
-	_size = sizeFile;
-	if (!_size)
-		return false;
-
-	_ttfFile = ttfFile;
-	assert(_ttfFile);
-
-	if (!g_ttf.loadFont(_ttfFile, faceIndex, _size, _face)) {
-		// Don't delete ttfFile as we return fail
-		_ttfFile = 0;
-
-		return false;
-	}
+void TTFLibrary::releaseFace(TTFFace *face) {
+	assert(face->_refCount > 0);
+	if (--face->_refCount)
+		return;
 
-	// Check if the fixed font has the requested size
-	if (!FT_IS_SCALABLE(_face)) {
-		FT_Pos reqsize = computePointSize(size, sizeMode) * 64;
-		bool found = false;
+	_faces.erase(face->getKey());
+	delete face;
+}
 
-		for (int i = 0; i < _face->num_fixed_sizes; i++)
-			if (_face->available_sizes[i].size == reqsize) {
-				found = true;
-				break;
-			}
+TTFFace::TTFFace(const Common::String &key, FT_Face face, uint8 *ttfFile)
+	: _refCount(1), _key(key), _face(face), _ttfFile(ttfFile), _width(0), _height(0), _ascent(0),
+	  _descent(0), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
+	  _hasKerning(false), _fakeBold(false), _fakeItalic(false) {
+}
 
-		if (!found) {
-			warning("The non-scalable font has no requested size: %ld", reqsize);
+TTFFace::~TTFFace() {
+	g_ttf.closeFont(_face);
 
-			g_ttf.closeFont(_face);
+	delete[] _ttfFile;
+	_ttfFile = 0;
 
-			// Don't delete ttfFile as we return fail
-			_ttfFile = 0;
+	for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
+		i->_value.image.free();
+}
 
-			return false;
-		}
-	}
+bool TTFFace::setup(int pointSize, uint xdpi, uint ydpi, TTFRenderMode renderMode, bool fakeBold, bool fakeItalic, bool stemDarkening) {
 	if (stemDarkening) {
 #if FREETYPE_MAJOR > 2 || ( FREETYPE_MAJOR == 2 &&  FREETYPE_MINOR >= 9)
 		FT_Parameter param;
@@ -303,19 +291,11 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 	// Check whether we have kerning support
 	_hasKerning = (FT_HAS_KERNING(_face) != 0);
 
-	if (FT_Set_Char_Size(_face, 0, computePointSize(size, sizeMode) * 64, xdpi, ydpi)) {
-		g_ttf.closeFont(_face);
-
-		// Don't delete ttfFile as we return fail
-		_ttfFile = 0;
-
+	if (FT_Set_Char_Size(_face, 0, pointSize * 64, xdpi, ydpi))
 		return false;
-	}
 
-	bool fontBold = ((_face->style_flags & FT_STYLE_FLAG_BOLD) != 0);
-	_fakeBold = bold && !fontBold;
-	bool fontItalic = ((_face->style_flags & FT_STYLE_FLAG_ITALIC) != 0);
-	_fakeItalic = italic && !fontItalic;
+	_fakeBold = fakeBold;
+	_fakeItalic = fakeItalic;
 
 	switch (renderMode) {
 	case kTTFRenderModeNormal:
@@ -367,65 +347,260 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		_loadFlags |= FT_LOAD_NO_BITMAP;
 	}
 
+	return true;
+}
+
+const TTFFace::Glyph *TTFFace::findGlyph(uint32 chr, bool allowCaching) {
+	// A single lookup covers the common case of an already cached glyph.
+	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
+	if (glyphEntry != _glyphs.end())
+		return &glyphEntry->_value;
+
+	if (!allowCaching)
+		return nullptr;
+
+	Glyph newGlyph;
+	if (!cacheGlyph(newGlyph, chr))
+		return nullptr;
+
+	Glyph &glyph = _glyphs[chr];
+	glyph = newGlyph;
+	return &glyph;
+}
+
+int TTFFace::getKerningOffset(FT_UInt leftGlyph, FT_UInt rightGlyph) {
+	const bool cacheable = (leftGlyph <= 0xFFFF && rightGlyph <= 0xFFFF);
+	const uint32 pairKey = (leftGlyph << 16) | rightGlyph;
+	if (cacheable) {
+		KerningCache::const_iterator pairEntry = _kerningPairs.find(pairKey);
+		if (pairEntry != _kerningPairs.end())
+			return pairEntry->_value;
+	}
+
+	FT_Vector kerningVector;
+	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
+	const int offset = kerningVector.x / 64;
+
+	if (cacheable)
+		_kerningPairs[pairKey] = offset;
+	return offset;
+}
+
+class TTFFont : public Font {
+public:
+	TTFFont();
+	~TTFFont() override;
+
+	bool load(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode,
+	          uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening);
+	bool load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool fakeBold, bool fakeItalic,
+	          int size, TTFSizeMode sizeMode, uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening);
+
+	int getFontHeight() const override;
+	Common::String getFontName() const override;
+	int getFontAscent() const override;
+
+	int getMaxCharWidth() const override;
+
+	int getCharWidth(uint32 chr) const override;
+
+	int getKerningOffset(uint32 left, uint32 right) const override;
+
+	Common::Rect getBoundingBox(uint32 chr) const override;
+
+	void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const override;
+	void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const override;
+
+private:
+	typedef TTFFace::Glyph Glyph;
+
+	// Shared with other fonts using the same face and options
+	TTFFace *_face;
+
+	bool _allowLateCaching;
+	const Glyph *findGlyph(uint32 chr) const;
+
+	// Code points of the 256 characters, if loaded with a mapping
+	bool _hasMapping;
+	uint32 _mapping[256];
+
+	static Common::SeekableReadStream *readTTFTable(FT_Face face, FT_ULong tag);
+
+	static int computePointSize(FT_Face face, int size, TTFSizeMode sizeMode);
+	static int readPointSizeFromVDMXTable(FT_Face face, int height);
+	static int computePointSizeFromHeaders(FT_Face face, int height);
+	void drawGlyph(Surface *dst, const Glyph &glyph, int x, int y, uint32 color,
+		const uint32 *transparentColor) const;
+};
+
+TTFFont::TTFFont()
+	: _face(nullptr), _allowLateCaching(false), _hasMapping(false) {
+}
+
+TTFFont::~TTFFont() {
+	if (_face)
+		g_ttf.releaseFace(_face);
+}
+
+bool TTFFont::load(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode,
+				   uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
+	if (!g_ttf.isInitialized())
+		return false;
+
+	uint32 sizeFile = stream.size();
+	if (!sizeFile)
+		return false;
+
+	uint8 *ttfFile = new uint8[sizeFile];
+	assert(ttfFile);
+
+	if (stream.read(ttfFile, sizeFile) != sizeFile) {
+		delete[] ttfFile;
+		return false;
+	}
+
+	if (!load(ttfFile, sizeFile, 0, false, false, size, sizeMode, xdpi, ydpi, renderMode, mapping, stemDarkening)) {
+		delete[] ttfFile;
+		return false;
+	}
+
+	// Don't delete ttfFile as it's now owned by the class
+	return true;
+}
+
+bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold, bool italic,
+				   int size, TTFSizeMode sizeMode, uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
+	assert(!_face);
+
+	if (!g_ttf.isInitialized())
+		return false;
+
+	if (!sizeFile)
+		return false;
+
+	assert(ttfFile);
+
+	FT_Face face;
+	if (!g_ttf.loadFont(ttfFile, faceIndex, sizeFile, face)) {
+		// Don't delete ttfFile as we return fail
+		return false;
+	}
+
+	const int pointSize = computePointSize(face, size, sizeMode);
+
+	// Check if the fixed font has the requested size
+	if (!FT_IS_SCALABLE(face)) {
+		FT_Pos reqsize = pointSize * 64;
+		bool found = false;
+
+		for (int i = 0; i < face->num_fixed_sizes; i++)
+			if (face->available_sizes[i].size == reqsize) {
+				found = true;
+				break;
+			}
+
+		if (!found) {
+			warning("The non-scalable font has no requested size: %ld", reqsize);
+
+			g_ttf.closeFont(face);
+
+			// Don't delete ttfFile as we return fail
+			return false;
+		}
+	}
+
+	bool fontBold = ((face->style_flags & FT_STYLE_FLAG_BOLD) != 0);
+	const bool fakeBold = bold && !fontBold;
+	bool fontItalic = ((face->style_flags & FT_STYLE_FLAG_ITALIC) != 0);
+	const bool fakeItalic = italic && !fontItalic;
+
+	// Fonts are loaded from a copy of the file each time, so the face is
+	// identified by a hash of the file data instead.
+	Common::MemoryReadStream fileStream(ttfFile, sizeFile);
+	const Common::String key = Common::String::format("%s|%u|%d|%d|%u|%u|%d|%d|%d|%d",
+		Common::computeStreamMD5AsString(fileStream).c_str(), sizeFile, faceIndex, pointSize,
+		xdpi, ydpi, renderMode, fakeBold, fakeItalic, stemDarkening);
+
+	_face = g_ttf.acquireFace(key);
+	const bool newFace = !_face;
+	if (newFace) {
+		_face = new TTFFace(key, face, ttfFile);
+		if (!_face->setup(pointSize, xdpi, ydpi, renderMode, fakeBold, fakeItalic, stemDarkening)) {
+			// Don't delete ttfFile as we return fail
+			_face->releaseFile();
+			delete _face;
+			_face = nullptr;
+
+			return false;
+		}
+		g_ttf.registerFace(_face);
+	}
+
+	uint numGlyphs = 0;
 	if (!mapping) {
 		// Allow loading of all unicode characters.
 		_allowLateCaching = true;
+		_hasMapping = false;
 
 		// Load all ISO-8859-1 characters.
 		for (uint i = 0; i < 256; ++i) {
-			if (!cacheGlyph(_glyphs[i], i)) {
-				_glyphs.erase(i);
-			}
+			if (_face->findGlyph(i, true))
+				++numGlyphs;
 		}
 	} else {
 		// We have a fixed map of characters do not load more later.
 		_allowLateCaching = false;
+		_hasMapping = true;
 
 		for (uint i = 0; i < 256; ++i) {
 			const uint32 unicode = mapping[i] & 0x7FFFFFFF;
 			const bool isRequired = (mapping[i] & 0x80000000) != 0;
+			_mapping[i] = unicode;
+
 			// Check whether loading an important glyph fails and error out if
 			// that is the case.
-			if (!cacheGlyph(_glyphs[i], unicode)) {
-				_glyphs.erase(i);
-				if (isRequired) {
-					g_ttf.closeFont(_face);
-
-					// Don't delete ttfFile as we return fail
-					_ttfFile = 0;
-
-					return false;
-				}
+			if (_face->findGlyph(unicode, true)) {
+				++numGlyphs;
+			} else if (isRequired) {
+				numGlyphs = 0;
+				break;
 			}
 		}
 	}
 
-	if (_glyphs.size() == 0) {
-		g_ttf.closeFont(_face);
-
+	if (numGlyphs == 0) {
 		// Don't delete ttfFile as we return fail
-		_ttfFile = 0;
+		if (newFace)
+			_face->releaseFile();
+		else
+			g_ttf.closeFont(face);
+		g_ttf.releaseFace(_face);
+		_face = nullptr;
 
 		return false;
-	} else {
-		_initialized = true;
-		// At this point we get ownership of _ttfFile
-		return true;
 	}
+
+	// At this point we get ownership of ttfFile, which is not needed if the
+	// face was loaded already.
+	if (!newFace) {
+		g_ttf.closeFont(face);
+		delete[] ttfFile;
+	}
+	return true;
 }
 
-int TTFFont::computePointSize(int size, TTFSizeMode sizeMode) const {
+int TTFFont::computePointSize(FT_Face face, int size, TTFSizeMode sizeMode) {
 	int ptSize = 0;
 	switch (sizeMode) {
 	case kTTFSizeModeCell: {
-		ptSize = readPointSizeFromVDMXTable(size);
+		ptSize = readPointSizeFromVDMXTable(face, size);
 
 		if (ptSize == 0) {
-			ptSize = computePointSizeFromHeaders(size);
+			ptSize = computePointSizeFromHeaders(face, size);
 		}
 
 		if (ptSize == 0) {
-			warning("Unable to compute point size for font '%s'", _face->family_name);
+			warning("Unable to compute point size for font '%s'", face->family_name);
 			ptSize = 1;
 		}
 		break;
@@ -440,10 +615,10 @@ int TTFFont::computePointSize(int size, TTFSizeMode sizeMode) const {
 	return ptSize;
 }
 
-Common::SeekableReadStream *TTFFont::readTTFTable(FT_ULong tag) const {
+Common::SeekableReadStream *TTFFont::readTTFTable(FT_Face face, FT_ULong tag) {
 	// Find the required buffer size by calling the load function with nullptr
 	FT_ULong size = 0;
-	FT_Error err = FT_Load_Sfnt_Table(_face, tag, 0, nullptr, &size);
+	FT_Error err = FT_Load_Sfnt_Table(face, tag, 0, nullptr, &size);
 	if (err) {
 		return nullptr;
 	}
@@ -453,7 +628,7 @@ Common::SeekableReadStream *TTFFont::readTTFTable(FT_ULong tag) const {
 		return nullptr;
 	}
 
-	err = FT_Load_Sfnt_Table(_face, tag, 0, buf, &size);
+	err = FT_Load_Sfnt_Table(face, tag, 0, buf, &size);
 	if (err) {
 		free(buf);
 		return nullptr;
@@ -462,12 +637,12 @@ Common::SeekableReadStream *TTFFont::readTTFTable(FT_ULong tag) const {
 	return new Common::MemoryReadStream(buf, size, DisposeAfterUse::YES);
 }
 
-int TTFFont::readPointSizeFromVDMXTable(int height) const {
+int TTFFont::readPointSizeFromVDMXTable(FT_Face face, int height) {
 	// The Vertical Device Metrics table matches font heights with point sizes.
 	// FreeType does not expose it, we have to parse it ourselves.
 	// See https://docs.microsoft.com/en-us/typography/opentype/spec/vdmx
 
-	Common::ScopedPtr<Common::SeekableReadStream> vdmxBuf(readTTFTable(TTAG_VDMX));
+	Common::ScopedPtr<Common::SeekableReadStream> vdmxBuf(readTTFTable(face, TTAG_VDMX));
 	if (!vdmxBuf) {
 		return 0;
 	}
@@ -523,87 +698,67 @@ int TTFFont::readPointSizeFromVDMXTable(int height) const {
 	return 0;
 }
 
-int TTFFont::computePointSizeFromHeaders(int height) const {
-	TT_OS2 *os2Header = (TT_OS2 *)FT_Get_Sfnt_Table(_face, ft_sfnt_os2);
-	TT_HoriHeader *horiHeader = (TT_HoriHeader *)FT_Get_Sfnt_Table(_face, ft_sfnt_hhea);
+int TTFFont::computePointSizeFromHeaders(FT_Face face, int height) {
+	TT_OS2 *os2Header = (TT_OS2 *)FT_Get_Sfnt_Table(face, ft_sfnt_os2);
+	TT_HoriHeader *horiHeader = (TT_HoriHeader *)FT_Get_Sfnt_Table(face, ft_sfnt_hhea);
 
 	if (os2Header && (os2Header->usWinAscent + os2Header->usWinDescent != 0)) {
-		return divRoundToNearest(_face->units_per_EM * height, os2Header->usWinAscent + os2Header->usWinDescent);
+		return divRoundToNearest(face->units_per_EM * height, os2Header->usWinAscent + os2Header->usWinDescent);
 	} else if (horiHeader && (horiHeader->Ascender + horiHeader->Descender != 0)) {
-		return divRoundToNearest(_face->units_per_EM * height, horiHeader->Ascender + horiHeader->Descender);
+		return divRoundToNearest(face->units_per_EM * height, horiHeader->Ascender + horiHeader->Descender);
 	}
 
 	return 0;
 }
 
 int TTFFont::getFontHeight() const {
-	return _height;
+	return _face->getHeight();
 }
 
 Common::String TTFFont::getFontName() const {
-	return _face->family_name;
+	return _face->getFamilyName();
 }
 
 int TTFFont::getFontAscent() const {
-	return _ascent;
+	return _face->getAscent();
 }
 
 int TTFFont::getMaxCharWidth() const {
-	return _width;
+	return _face->getMaxCharWidth();
 }
 
 int TTFFont::getCharWidth(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return 0;
-	else
-		return glyphEntry->_value.advance;
+	const Glyph *glyph = findGlyph(chr);
+	return glyph ? glyph->advance : 0;
 }
 
 int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
-	if (!_hasKerning)
+	if (!_face->hasKerning())
 		return 0;
 
-	assureCached(left);
-	assureCached(right);
-
-	FT_UInt leftGlyph, rightGlyph;
-	GlyphCache::const_iterator glyphEntry;
-
-	glyphEntry = _glyphs.find(left);
-	if (glyphEntry != _glyphs.end()) {
-		leftGlyph = glyphEntry->_value.slot;
-	} else {
+	const Glyph *glyph = findGlyph(left);
+	if (!glyph)
 		return 0;
-	}
+	const FT_UInt leftGlyph = glyph->slot;
 
-	glyphEntry = _glyphs.find(right);
-	if (glyphEntry != _glyphs.end()) {
-		rightGlyph = glyphEntry->_value.slot;
-	} else {
+	glyph = findGlyph(right);
+	if (!glyph)
 		return 0;
-	}
+	const FT_UInt rightGlyph = glyph->slot;
 
 	if (!leftGlyph || !rightGlyph)
 		return 0;
 
-	FT_Vector kerningVector;
-	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	return _face->getKerningOffset(leftGlyph, rightGlyph);
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end()) {
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph)
 		return Common::Rect();
-	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
-		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
-	}
+
+	return Common::Rect(glyph->xOffset, glyph->yOffset,
+	                    glyph->xOffset + glyph->image.w, glyph->yOffset + glyph->image.h);
 }
 
 namespace {
@@ -632,16 +787,34 @@ static void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos,
 					dstFormat.colorToARGB(*rDst, dA, dR, dG, dB);
 				}
 
-				double sAn = (double)sA / 255.0;
-				double dAn = (double)dA / 255.0;
-				double oAn = sAn + dAn * (1.0 - sAn);
+				if (dA == 255) {
+					// Opaque destination, which includes every format
+					// without an alpha channel. The output stays opaque
+					// and the blend reduces to a plain integer lerp.
+					const uint iA = 255 - sA;
+					dR = (sR * sA + dR * iA) / 255;
+					dG = (sG * sA + dG * iA) / 255;
+					dB = (sB * sA + dB * iA) / 255;
+
+					*rDst = dstFormat.ARGBToColor(255, dR, dG, dB);
+				} else if (dA == 0) {
+					dR = (sR * sA) / 255;
+					dG = (sG * sA) / 255;
+					dB = (sB * sA) / 255;
+
+					*rDst = dstFormat.ARGBToColor(sA, dR, dG, dB);
+				} else {
+					double sAn = (double)sA / 255.0;
+					double dAn = (double)dA / 255.0;
+					double oAn = sAn + dAn * (1.0 - sAn);
 
-				dR = static_cast<uint8>(sR * sAn + dR * dAn * (1.0 - sAn) / oAn);
-				dG = static_cast<uint8>(sG * sAn + dG * dAn * (1.0 - sAn) / oAn);
-				dB = static_cast<uint8>(sB * sAn + dB * dAn * (1.0 - sAn) / oAn);
-				dA = static_cast<uint8>(oAn * 255.0);
+					dR = static_cast<uint8>(sR * sAn + dR * dAn * (1.0 - sAn) / oAn);
+					dG = static_cast<uint8>(sG * sAn + dG * dAn * (1.0 - sAn) / oAn);
+					dB = static_cast<uint8>(sB * sAn + dB * dAn * (1.0 - sAn) / oAn);
+					dA = static_cast<uint8>(oAn * 255.0);
 
-				*rDst = dstFormat.ARGBToColor(dA, dR, dG, dB);
+					*rDst = dstFormat.ARGBToColor(dA, dR, dG, dB);
+				}
 			}
 
 			++rDst;
@@ -656,31 +829,31 @@ static void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos,
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const {
-	drawChar(dst, chr, x, y, color, nullptr);
+	const Glyph *glyph = findGlyph(chr);
+	if (glyph)
+		drawGlyph(dst, *glyph, x, y, color, nullptr);
 }
 
 void TTFFont::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const {
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph)
+		return;
+
 	if (dst->hasTransparentColor()) {
 		uint32 transColor = dst->getTransparentColor();
-		drawChar(dst->surfacePtr(), chr, x, y, color, &transColor);
+		drawGlyph(dst->surfacePtr(), *glyph, x, y, color, &transColor);
 	} else {
-		drawChar(dst->surfacePtr(), chr, x, y, color, nullptr);
+		drawGlyph(dst->surfacePtr(), *glyph, x, y, color, nullptr);
 	}
 
-	Common::Rect charBox = getBoundingBox(chr);
+	Common::Rect charBox(glyph->xOffset, glyph->yOffset,
+	                     glyph->xOffset + glyph->image.w, glyph->yOffset + glyph->image.h);
 	charBox.translate(x, y);
 	dst->addDirtyRect(charBox);
 }
 
-void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
+void TTFFont::drawGlyph(Surface *dst, const Glyph &glyph, int x, int y, uint32 color,
 		const uint32 *transparentColor) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return;
-
-	const Glyph &glyph = glyphEntry->_value;
-
 	x += glyph.xOffset;
 	y += glyph.yOffset;
 
@@ -748,7 +921,7 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 	}
 }
 
-bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
+bool TTFFace::cacheGlyph(Glyph &glyph, uint32 chr) {
 	FT_UInt slot = FT_Get_Char_Index(_face, chr);
 	if (!slot)
 		return false;
@@ -854,7 +1027,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		break;
 
 	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
+		warning("TTFFace::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
 		glyph.image.free();
 		return false;
 	}
@@ -868,15 +1041,11 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	return true;
 }
 
-void TTFFont::assureCached(uint32 chr) const {
-	if (!chr || !_allowLateCaching || _glyphs.contains(chr)) {
-		return;
-	}
+const TTFFont::Glyph *TTFFont::findGlyph(uint32 chr) const {
+	if (_hasMapping)
+		return chr < 256 ? _face->findGlyph(_mapping[chr], false) : nullptr;
 
-	Glyph newGlyph;
-	if (cacheGlyph(newGlyph, chr)) {
-		_glyphs[chr] = newGlyph;
-	}
+	return _face->findGlyph(chr, chr && _allowLateCaching);
 }
 
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
@@ -28,6 +28,7 @@ namespace Common {
 DECLARE_SINGLETON(GUI::EventRecorder);
 }
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/mixer/mixer.h"
@@ -78,6 +79,13 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
 	_recordFile = nullptr;
+	_benchmark = false;
+	_benchmarkReported = false;
+	_benchmarkStart = 0;
+	_benchmarkFrameStart = 0;
+	_benchmarkScreenStart = 0;
+	_benchmarkScreenTime = 0;
+	_benchmarkMixerTime = 0;
 }
 
 EventRecorder::~EventRecorder() {
@@ -88,6 +96,10 @@ void EventRecorder::deinit() {
 	if (!_initialized) {
 		return;
 	}
+	if (_benchmark && !_benchmarkReported) {
+		printBenchmarkReport();
+	}
+	_benchmark = false;
 	setFileHeader();
 	_needRedraw = false;
 	_initialized = false;
@@ -161,7 +173,7 @@ void EventRecorder::processTimeAndDate(TimeDate &td, bool skipRecord) {
 			_recordFile->writeEvent(timeDateEvent);
 		}
 
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = readNextEvent();
 	}
 	if (_recordMode == kRecorderPlaybackPause)
 		td = _lastTimeDate;
@@ -218,7 +230,7 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 			_recordFile->writeEvent(timerEvent);
 		}
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = readNextEvent();
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
@@ -231,6 +243,50 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 	}
 }
 
+Common::RecorderEvent EventRecorder::readNextEvent() {
+	// The playback file quits as soon as it runs out of events,
+	// so the report has to be printed before that happens
+	if (_benchmark && !_benchmarkReported && !_playbackFile->hasNextEvent()) {
+		printBenchmarkReport();
+	}
+
+	return _playbackFile->getNextEvent();
+}
+
+uint64 EventRecorder::getRealMicros() const {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const uint64 counter = SDL_GetPerformanceCounter();
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
+void EventRecorder::updateBenchmark() {
+	uint64 now = getRealMicros();
+	_benchmarkFrameTimes.push_back(now - _benchmarkFrameStart);
+
+	// Screen hash checkpoints allow comparing the rendering between runs
+	if ((_fakeTimer - _lastScreenshotTime) > _screenshotPeriod) {
+		Graphics::Surface screen;
+		uint8 md5[16];
+		if (grabScreenAndComputeMD5(screen, md5)) {
+			BenchmarkCheckpoint checkpoint;
+			checkpoint.time = _fakeTimer;
+			for (int i = 0; i < 16; i++) {
+				checkpoint.md5 += Common::String::format("%02x", md5[i]);
+			}
+			_benchmarkCheckpoints.push_back(checkpoint);
+			screen.free();
+		}
+		_lastScreenshotTime = _fakeTimer;
+	}
+
+	// Don't account for the checkpoints in the frame times
+	_benchmarkFrameStart = getRealMicros();
+}
+
 bool EventRecorder::processDelayMillis() {
 	return _fastPlayback;
 }
@@ -260,7 +316,7 @@ void EventRecorder::processScreenUpdate() {
 		if (_nextEvent.recordedtype != Common::kRecorderEventTypeScreenUpdate) {
 			int numSkipped = 0;
 			while (true) {
-				_nextEvent = _playbackFile->getNextEvent();
+				_nextEvent = readNextEvent();
 				numSkipped += 1;
 				if (_nextEvent.recordedtype == Common::kRecorderEventTypeScreenUpdate) {
 					warning("Skipped %d events to get to the next screen update at %d", numSkipped, _nextEvent.time);
@@ -271,7 +327,7 @@ void EventRecorder::processScreenUpdate() {
 		_processingMillis = true;
 		_fakeTimer = _nextEvent.time;
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = readNextEvent();
 		if (_recordMode == kRecorderUpdate) {
 			// write event to the updated file and update screenshot if necessary
 			screenUpdateEvent.recordedtype = Common::kRecorderEventTypeScreenUpdate;
@@ -279,6 +335,9 @@ void EventRecorder::processScreenUpdate() {
 			_recordFile->writeEvent(screenUpdateEvent);
 			takeScreenshot();
 		}
+		if (_benchmark) {
+			updateBenchmark();
+		}
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
@@ -308,7 +367,7 @@ bool EventRecorder::pollEvent(Common::Event &ev) {
 	}
 
 	ev = _nextEvent;
-	_nextEvent = _playbackFile->getNextEvent();
+	_nextEvent = readNextEvent();
 	switch (ev.type) {
 	case Common::EVENT_MOUSEMOVE:
 	case Common::EVENT_LBUTTONDOWN:
@@ -380,7 +439,7 @@ Common::String EventRecorder::generateRecordFileName(const Common::String &targe
 }
 
 
-void EventRecorder::init(const Common::String &recordFileName, RecordMode mode) {
+void EventRecorder::init(const Common::String &recordFileName, RecordMode mode, bool benchmark) {
 	_fakeMixerManager = new NullMixerManager();
 	_fakeMixerManager->init();
 	_fakeMixerManager->suspendAudio();
@@ -413,9 +472,19 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 		_controlPanel = new GUI::OnScreenDialog(_recordMode == kRecorderRecord);
 		_controlPanel->reflowLayout();
 	}
+	_benchmark = benchmark && _recordMode == kRecorderPlayback;
+	if (_benchmark) {
+		_fastPlayback = true;
+		_benchmarkReported = false;
+		_benchmarkScreenTime = 0;
+		_benchmarkMixerTime = 0;
+		_benchmarkFrameTimes.clear();
+		_benchmarkCheckpoints.clear();
+		_recordFileName = recordFileName;
+	}
 	if ((_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate)) {
 		applyPlaybackSettings();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = readNextEvent();
 	}
 	if ((_recordMode == kRecorderRecord) || (_recordMode == kRecorderUpdate)) {
 		getConfig();
@@ -425,6 +494,50 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	switchTimerManagers();
 	_needRedraw = true;
 	_initialized = true;
+	_benchmarkStart = _benchmarkFrameStart = getRealMicros();
+}
+
+void EventRecorder::printBenchmarkReport() {
+	_benchmarkReported = true;
+
+	uint64 wallTime = getRealMicros() - _benchmarkStart;
+	uint64 frameTime = 0;
+	for (uint i = 0; i < _benchmarkFrameTimes.size(); i++) {
+		frameTime += _benchmarkFrameTimes[i];
+	}
+
+	Common::Array<uint32> sortedFrameTimes = _benchmarkFrameTimes;
+	Common::sort(sortedFrameTimes.begin(), sortedFrameTimes.end());
+
+	const uint percentiles[] = { 50, 90, 99, 100 };
+	Common::String frameTimes;
+	for (uint i = 0; i < ARRAYSIZE(percentiles); i++) {
+		uint32 value = 0;
+		if (!sortedFrameTimes.empty()) {
+			value = sortedFrameTimes[(sortedFrameTimes.size() - 1) * percentiles[i] / 100];
+		}
+		frameTimes += Common::String::format(" p%u=%u", percentiles[i], value);
+	}
+
+	// The frame times include the screen updates and the mixer, what remains is the engine
+	uint64 engineTime = frameTime;
+	engineTime -= MIN(engineTime, _benchmarkScreenTime);
+	engineTime -= MIN(engineTime, _benchmarkMixerTime);
+
+	// One line per entry in the same key=value style as the playback log
+	Common::String report;
+	report += Common::String::format("benchmark:action=report filename=%s\n", _recordFileName.c_str());
+	report += Common::String::format("benchmark:frames=%u replayed_ms=%u wall_ms=%u\n",
+	                                 _benchmarkFrameTimes.size(), (uint32)_fakeTimer, (uint32)(wallTime / 1000));
+	report += Common::String::format("benchmark:frame_us%s\n", frameTimes.c_str());
+	report += Common::String::format("benchmark:engine_ms=%u screen_ms=%u mixer_ms=%u\n",
+	                                 (uint32)(engineTime / 1000), (uint32)(_benchmarkScreenTime / 1000), (uint32)(_benchmarkMixerTime / 1000));
+	for (uint i = 0; i < _benchmarkCheckpoints.size(); i++) {
+		report += Common::String::format("benchmark:checkpoint time=%u md5=%s\n",
+		                                 _benchmarkCheckpoints[i].time, _benchmarkCheckpoints[i].md5.c_str());
+	}
+
+	g_system->logMessage(LogMessageType::kInfo, report.c_str());
 }
 
 
@@ -571,7 +684,11 @@ void EventRecorder::updateSubsystems() {
 	}
 	RecordMode oldRecordMode = _recordMode;
 	_recordMode = kPassthrough;
+	uint64 mixerStart = _benchmark ? getRealMicros() : 0;
 	_fakeMixerManager->update();
+	if (_benchmark) {
+		_benchmarkMixerTime += getRealMicros() - mixerStart;
+	}
 	_recordMode = oldRecordMode;
 }
 
@@ -699,6 +816,11 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
+	if (_benchmark) {
+		// The control panel is not drawn when benchmarking
+		_benchmarkScreenStart = getRealMicros();
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
@@ -716,6 +838,10 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
+	if (_benchmark) {
+		_benchmarkScreenTime += getRealMicros() - _benchmarkScreenStart;
+		return;
+	}
 	if ((_initialized) || (_needRedraw)) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
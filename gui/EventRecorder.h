@@ -77,7 +77,13 @@ public:
 		kRecorderUpdate = 4			/**< kRecorderUpdate, playback existing recording and update all hashes */
 	};
 
-	void init(const Common::String &recordFileName, RecordMode mode);
+	/**
+	 * Start recording or playing back.
+	 *
+	 * @param benchmark When playing back, replay as fast as possible and
+	 *                  print a timing report once the recording ends.
+	 */
+	void init(const Common::String &recordFileName, RecordMode mode, bool benchmark = false);
 	void deinit();
 	bool processDelayMillis();
 	uint32 getRandomSeed(const Common::String &name);
@@ -249,6 +255,26 @@ private:
 	bool _fastPlayback;
 	bool _needRedraw;
 	bool _processingMillis;
+
+	struct BenchmarkCheckpoint {
+		uint32 time;
+		Common::String md5;
+	};
+
+	bool _benchmark;
+	bool _benchmarkReported;
+	uint64 _benchmarkStart;
+	uint64 _benchmarkFrameStart;
+	uint64 _benchmarkScreenStart;
+	uint64 _benchmarkScreenTime;
+	uint64 _benchmarkMixerTime;
+	Common::Array<uint32> _benchmarkFrameTimes;
+	Common::Array<BenchmarkCheckpoint> _benchmarkCheckpoints;
+
+	Common::RecorderEvent readNextEvent();
+	uint64 getRealMicros() const;
+	void updateBenchmark();
+	void printBenchmarkReport();
 };
 
 } // End of namespace GUI
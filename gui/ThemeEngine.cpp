@@ -85,6 +85,9 @@ struct WidgetDrawData {
 
 	DrawLayer _layer;
 
+	/** Whether the steps are costly enough to be worth caching their output */
+	bool _cacheable;
+
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -92,10 +95,36 @@ struct WidgetDrawData {
 	 * called in order to calculate if such draw steps would be drawn outside of
 	 * the actual widget drawing zone (e.g. shadows). If this is the case, a constant
 	 * value will be added when restoring the background of the widget.
+	 *
+	 * It also decides whether the DrawData goes through the render cache.
 	 */
 	void calcBackgroundOffset();
 };
 
+/**
+ * Output of the draw steps of a DrawData. The steps only depend on the key
+ * fields and on the pixels already under the widget, so those pixels are
+ * kept as well and must match for the cached result to be reused.
+ */
+struct CachedRender {
+	DrawData type;
+	Common::Rect area;
+	Common::Rect clip;
+	uint32 dynamic;
+	const Graphics::ManagedSurface *target;
+	Graphics::VectorRenderer::ColorState colors;
+
+	/** Part of the target the steps may touch */
+	Common::Rect rect;
+	Graphics::Surface before;
+	Graphics::Surface after;
+
+	~CachedRender() {
+		before.free();
+		after.free();
+	}
+};
+
 /**********************************************************
  *  Data definitions for theme engine elements
  *********************************************************/
@@ -227,6 +256,9 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_themeArchive = nullptr;
 	_initOk = false;
 
+	_renderCacheSize = 0;
+	_renderCacheHits = _renderCacheMisses = 0;
+
 	_cursorHotspotX = _cursorHotspotY = 0;
 	_cursorWidth = _cursorHeight = 0;
 	_cursorTransparent = 255;
@@ -238,6 +270,8 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 }
 
 ThemeEngine::~ThemeEngine() {
+	clearRenderCache();
+
 	delete _vectorRenderer;
 	_vectorRenderer = nullptr;
 	_screen.free();
@@ -469,10 +503,14 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	// list. Clearing it avoids invalid overlay writes when the backend
 	// resizes the overlay.
 	_dirtyScreen.clear();
+
+	// Cached renders refer to the old surfaces and pixel format.
+	clearRenderCache();
 }
 
 void WidgetDrawData::calcBackgroundOffset() {
 	uint maxShadow = 0, maxBevel = 0;
+	_cacheable = false;
 	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
 	        step != _steps.end(); ++step) {
 		if ((step->autoWidth || step->autoHeight) && step->shadow > maxShadow)
@@ -480,6 +518,16 @@ void WidgetDrawData::calcBackgroundOffset() {
 
 		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_BEVELSQ && step->bevel > maxBevel)
 			maxBevel = step->bevel;
+
+		// Plain fills and lines are cheaper to draw again than to validate
+		// and blit from the cache. Gradients, shadows, rounded shapes and
+		// bitmaps are not.
+		if (step->fillMode == Graphics::VectorRenderer::kFillGradient || step->shadow || step->bevel ||
+		        (step->drawingCall != &Graphics::VectorRenderer::drawCallback_SQUARE &&
+		         step->drawingCall != &Graphics::VectorRenderer::drawCallback_LINE &&
+		         step->drawingCall != &Graphics::VectorRenderer::drawCallback_FILLSURFACE &&
+		         step->drawingCall != &Graphics::VectorRenderer::drawCallback_VOID))
+			_cacheable = true;
 	}
 
 	_backgroundOffset = maxBevel;
@@ -748,6 +796,7 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_layer = kDrawDataDefaults[id].layer;
+	_widgets[id]->_cacheable = false;
 	_widgets[id]->_textDataId = kTextDataNone;
 
 	return true;
@@ -786,6 +835,8 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 }
 
 void ThemeEngine::unloadTheme() {
+	clearRenderCache();
+
 	if (!_themeOk)
 		return;
 
@@ -948,13 +999,137 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
+		drawDDSteps(type, *drawData, area, extendedRect, dynamic);
+		addDirtyRect(extendedRect);
+	}
+}
+
+namespace {
+
+bool equalPixels(const Graphics::Surface &cached, const Graphics::Surface &surface, const Common::Rect &r) {
+	const uint lineSize = r.width() * surface.format.bytesPerPixel;
+	for (int y = 0; y < r.height(); ++y) {
+		if (memcmp(cached.getBasePtr(0, y), surface.getBasePtr(r.left, r.top + y), lineSize))
+			return false;
+	}
+	return true;
+}
+
+} // End of anonymous namespace
+
+uint ThemeEngine::CachedRender_Hash::operator()(const CachedRender *x) const {
+	uint hash = x->type;
+	hash = hash * 31 + x->area.left;
+	hash = hash * 31 + x->area.top;
+	hash = hash * 31 + x->area.right;
+	hash = hash * 31 + x->area.bottom;
+	hash = hash * 31 + x->dynamic;
+	hash = hash * 31 + x->colors.fg;
+	hash = hash * 31 + x->colors.bg;
+	return hash;
+}
+
+bool ThemeEngine::CachedRender_EqualTo::operator()(const CachedRender *x, const CachedRender *y) const {
+	return x->type == y->type && x->area == y->area && x->clip == y->clip && x->dynamic == y->dynamic &&
+	       x->target == y->target && x->colors == y->colors && x->rect == y->rect;
+}
+
+void ThemeEngine::drawDDSteps(DrawData type, const WidgetDrawData &drawData, const Common::Rect &area,
+                              const Common::Rect &extendedRect, uint32 dynamic) {
+	Graphics::ManagedSurface *target = _vectorRenderer->getActiveSurface();
+
+	Common::Rect rect = extendedRect;
+	rect.clip(target->w, target->h);
+	const uint32 rectSize = rect.width() * rect.height() * target->format.bytesPerPixel;
+
+	if (!drawData._cacheable || rect.isEmpty() || 2 * rectSize > kRenderCacheMaxBytes / 2) {
 		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+		for (step = drawData._steps.begin(); step != drawData._steps.end(); ++step) {
 			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
 		}
+		return;
+	}
 
-		addDirtyRect(extendedRect);
+	const Graphics::VectorRenderer::ColorState colors = _vectorRenderer->getColorState();
+	const Graphics::Surface &surface = *target->surfacePtr();
+
+	CachedRender key;
+	key.type = type;
+	key.area = area;
+	key.clip = _clip;
+	key.dynamic = dynamic;
+	key.target = target;
+	key.colors = colors;
+	key.rect = rect;
+
+	CachedRender *entry = nullptr;
+	RenderCacheMap::iterator cached = _renderCacheMap.find(&key);
+	if (cached != _renderCacheMap.end()) {
+		entry = *cached->_value;
+		_renderCache.erase(cached->_value);
+		_renderCacheMap.erase(cached);
+	}
+
+	if (entry && equalPixels(entry->before, surface, rect)) {
+		target->surfacePtr()->copyRectToSurface(entry->after, rect.left, rect.top,
+		                                        Common::Rect(rect.width(), rect.height()));
+
+		// Leave the renderer in the state drawing the steps would have.
+		Common::List<Graphics::DrawStep>::const_iterator step;
+		for (step = drawData._steps.begin(); step != drawData._steps.end(); ++step) {
+			_vectorRenderer->applyStepState(area, _clip, *step, dynamic);
+		}
+
+		_renderCache.push_front(entry);
+		_renderCacheMap[entry] = _renderCache.begin();
+		++_renderCacheHits;
+		return;
 	}
+
+	// Same widget over a different background: reuse the entry for the new
+	// render rather than keeping both.
+	if (!entry) {
+		entry = new CachedRender();
+		entry->type = type;
+		entry->area = area;
+		entry->clip = _clip;
+		entry->dynamic = dynamic;
+		entry->target = target;
+		entry->colors = colors;
+		entry->rect = rect;
+		entry->before.create(rect.width(), rect.height(), target->format);
+		entry->after.create(rect.width(), rect.height(), target->format);
+		_renderCacheSize += 2 * rectSize;
+	}
+
+	entry->before.copyRectToSurface(surface, 0, 0, rect);
+
+	Common::List<Graphics::DrawStep>::const_iterator step;
+	for (step = drawData._steps.begin(); step != drawData._steps.end(); ++step) {
+		_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+	}
+
+	entry->after.copyRectToSurface(surface, 0, 0, rect);
+	_renderCache.push_front(entry);
+	_renderCacheMap[entry] = _renderCache.begin();
+	++_renderCacheMisses;
+
+	while (_renderCacheSize > kRenderCacheMaxBytes) {
+		CachedRender *oldest = _renderCache.back();
+		_renderCacheSize -= 2 * oldest->rect.width() * oldest->rect.height() * oldest->target->format.bytesPerPixel;
+		_renderCacheMap.erase(oldest);
+		_renderCache.pop_back();
+		delete oldest;
+	}
+}
+
+void ThemeEngine::clearRenderCache() {
+	for (RenderCacheList::iterator i = _renderCache.begin(); i != _renderCache.end(); ++i)
+		delete *i;
+
+	_renderCache.clear();
+	_renderCacheMap.clear();
+	_renderCacheSize = 0;
 }
 
 void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text,
@@ -1561,6 +1736,12 @@ void ThemeEngine::addDirtyRect(Common::Rect r) {
 }
 
 void ThemeEngine::updateDirtyScreen() {
+	if (_renderCacheHits || _renderCacheMisses) {
+		debug(7, "ThemeEngine: %u widgets blitted from the render cache, %u rasterized (%u KB cached)",
+		      _renderCacheHits, _renderCacheMisses, _renderCacheSize / 1024);
+		_renderCacheHits = _renderCacheMisses = 0;
+	}
+
 	if (_dirtyScreen.empty())
 		return;
 
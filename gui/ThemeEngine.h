@@ -48,6 +48,7 @@ class VectorRenderer;
 namespace GUI {
 
 struct WidgetDrawData;
+struct CachedRender;
 struct TextDrawData;
 class Dialog;
 class GuiObject;
@@ -340,6 +341,9 @@ public:
 	/** Constant value to expand dirty rectangles, to make sure they are fully copied */
 	static const int kDirtyRectangleThreshold = 1;
 
+	/** Memory budget for the pixels of rendered DrawData kept for reuse */
+	static const uint32 kRenderCacheMaxBytes = 16 * 1024 * 1024;
+
 	struct Renderer {
 		const char *name;
 		const char *shortname;
@@ -718,6 +722,18 @@ protected:
 	                TextAlignVertical alignV = kTextAlignVTop, int deltax = 0,
 	                const Common::Rect &drawableTextArea = Common::Rect(0, 0, 0, 0));
 
+	/**
+	 * Runs the draw steps of a DrawData, or blits the result of an earlier
+	 * identical call from the render cache.
+	 *
+	 * @param extendedRect Area of the active surface the steps may touch.
+	 */
+	void drawDDSteps(DrawData type, const WidgetDrawData &drawData, const Common::Rect &area,
+	                 const Common::Rect &extendedRect, uint32 dynamic);
+
+	/** Drops all the rendered DrawData cached by drawDDSteps. */
+	void clearRenderCache();
+
 	/**
 	 * DEBUG: Draws a white square and writes some text next to it.
 	 */
@@ -807,6 +823,25 @@ protected:
 	/** List of all the dirty screens that must be blitted to the overlay. */
 	Common::List<Common::Rect> _dirtyScreen;
 
+	struct CachedRender_Hash {
+		uint operator()(const CachedRender *x) const;
+	};
+
+	struct CachedRender_EqualTo {
+		bool operator()(const CachedRender *x, const CachedRender *y) const;
+	};
+
+	typedef Common::List<CachedRender *> RenderCacheList;
+	typedef Common::HashMap<const CachedRender *, RenderCacheList::iterator, CachedRender_Hash, CachedRender_EqualTo> RenderCacheMap;
+
+	/** Rendered DrawData, most recently used first. */
+	RenderCacheList _renderCache;
+	/** Position of the entries in _renderCache, found by their key fields. */
+	RenderCacheMap _renderCacheMap;
+	uint32 _renderCacheSize; ///< Bytes of pixel data held by _renderCache
+	uint _renderCacheHits;   ///< DrawData blitted from the cache since the last screen update
+	uint _renderCacheMisses; ///< DrawData rasterized since the last screen update
+
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
 	bool _enabled; ///< Whether the Theme is currently shown on the overlay
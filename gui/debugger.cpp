@@ -26,6 +26,7 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/system.h"
+#include "common/tracing.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
@@ -36,6 +37,8 @@
 
 #include "engines/engine.h"
 
+#include "audio/mixer.h"
+
 #include "gui/debugger.h"
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 	#include "gui/console.h"
@@ -81,6 +84,10 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+	registerCmd("mixer_stats",		WRAP_METHOD(Debugger, cmdMixerStats));
+#ifdef ENABLE_TRACING
+	registerCmd("trace",			WRAP_METHOD(Debugger, cmdTrace));
+#endif
 }
 
 Debugger::~Debugger() {
@@ -857,6 +864,71 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdMixerStats(int argc, const char **argv) {
+	Audio::Mixer *mixer = g_system->getMixer();
+
+	if (argc >= 2 && !scumm_stricmp(argv[1], "reset")) {
+		mixer->resetStats();
+		debugPrintf("Mixer statistics reset\n");
+		return true;
+	}
+
+	static const char *const soundTypes[] = { "plain", "music", "sfx", "speech" };
+
+	const uint rate = mixer->getOutputRate();
+	const uint bufSize = mixer->getOutputBufSize();
+	debugPrintf("Output: %u Hz, %s, %u samples per callback\n", rate, mixer->getOutputStereo() ? "stereo" : "mono", bufSize);
+
+	const Audio::Mixer::Stats stats = mixer->getStats();
+	debugPrintf("Callbacks: %u, output underruns: %u, starved channels: %u, peak active channels: %u\n",
+	            stats.callbacks, stats.outputUnderruns, stats.starvedChannels, stats.peakActiveChannels);
+#ifdef ENABLE_TRACING
+	if (stats.callbacks) {
+		debugPrintf("Mix time: last %u us, max %u us, average %u us, budget %u us, over budget: %u\n",
+		            stats.lastMixTime, stats.maxMixTime, (uint32)(stats.totalMixTime / stats.callbacks),
+		            rate ? (uint32)((uint64)bufSize * 1000000 / rate) : 0, stats.overBudgetCallbacks);
+	}
+#endif
+
+	const Common::Array<Audio::Mixer::ChannelStats> channels = mixer->getChannelStats();
+	for (uint i = 0; i < channels.size(); i++) {
+		const Audio::Mixer::ChannelStats &channel = channels[i];
+		debugPrintf("Channel %d (%s): mixed %u times, starved %u times", channel.id, soundTypes[channel.type], channel.mixes, channel.starved);
+#ifdef ENABLE_TRACING
+		if (channel.mixes)
+			debugPrintf(", mix time max %u us, average %u us", channel.maxMixTime, (uint32)(channel.totalMixTime / channel.mixes));
+#endif
+		debugPrintf("\n");
+	}
+
+	if (argc < 2)
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+	return true;
+}
+
+#ifdef ENABLE_TRACING
+bool Debugger::cmdTrace(int argc, const char **argv) {
+	if (argc >= 2 && !scumm_stricmp(argv[1], "start")) {
+		Common::startTracing();
+		debugPrintf("Tracing started\n");
+	} else if (argc >= 2 && !scumm_stricmp(argv[1], "stop")) {
+		Common::stopTracing();
+		debugPrintf("Tracing stopped\n");
+	} else if (argc >= 3 && !scumm_stricmp(argv[1], "write")) {
+		Common::Path path(argv[2], Common::Path::kNativeSeparator);
+		if (Common::writeTrace(path)) {
+			debugPrintf("Trace written to %s\n", argv[2]);
+		} else {
+			debugPrintf("Failed to write trace to %s\n", argv[2]);
+		}
+	} else {
+		debugPrintf("Tracing is %s\n", Common::isTracing() ? "running" : "stopped");
+		debugPrintf("Usage: %s start | stop | write <file>\n", argv[0]);
+	}
+	return true;
+}
+#endif
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
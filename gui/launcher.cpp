@@ -1012,6 +1012,7 @@ public:
 
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
 	void handleKeyDown(Common::KeyState state) override;
+	void handleTickle() override;
 
 	LauncherDisplayType getType() const override { return kLauncherDisplayGrid; }
 
@@ -1514,6 +1515,14 @@ void LauncherGrid::handleKeyDown(Common::KeyState state) {
 	updateButtons();
 }
 
+void LauncherGrid::handleTickle() {
+	// The grid streams its thumbnails in, whichever widget has the focus.
+	if (_grid)
+		_grid->handleTickle();
+
+	LauncherDialog::handleTickle();
+}
+
 void LauncherGrid::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 
 	switch (cmd) {
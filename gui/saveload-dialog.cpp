@@ -809,6 +809,9 @@ enum {
 	kNewSaveCmd = 'SAVE'
 };
 
+// Time spent querying save meta infos per tickle
+static const uint32 kMetaInfoLoadMillis = 15;
+
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::U32String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
 	_curPage(0), _newSaveContainer(nullptr), _nextFreeSaveSlot(0), _buttons() {
@@ -1140,63 +1143,22 @@ void SaveLoadChooserGrid::hideButtons() {
 
 void SaveLoadChooserGrid::updateSaves() {
 	hideButtons();
-
-	bool isWriteProtected = false;
+	_pendingSlots.clear();
 
 	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
-
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
-		if (!_saveList[i].getLocked() && desc.getSaveSlot() >= 0 && !desc.getDescription().empty())
-			_saveList[i] = desc;
 		SlotButton &curButton = _buttons[curNum];
 		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + _saveList[i].getDescription());
+		updateSlotButton(curButton, i, _saveList[i]);
 
-		Common::U32String tooltip(_("Name: "));
-		tooltip += _saveList[i].getDescription();
+		// Slots which were shown before keep the thumbnail they got then,
+		// the others show a placeholder until handleTickle() queries them.
+		if (!_saveList[i].getLocked() && !_saveList[i].getThumbnail()) {
+			_pendingSlots.push_back(i);
 
-		if (_saveDateSupport) {
-			const Common::U32String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip +=  _("Date: ") + saveDate;
-			}
-
-			const Common::U32String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Time: ") + saveTime;
-			}
+			// The write protection is only known once queried
+			if (_saveMode)
+				curButton.button->setEnabled(false);
 		}
-
-		if (_playTimeSupport) {
-			const Common::U32String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += Common::U32String("\n");
-				tooltip += _("Playtime: ") + playTime;
-			}
-		}
-
-		curButton.button->setTooltip(tooltip);
-
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		// We also disable and description the button if slot is locked
-		isWriteProtected = desc.getWriteProtectedFlag() ||
-			_saveList[i].getWriteProtectedFlag();
-		if ((_saveMode && isWriteProtected) || desc.getLocked()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
-		}
-		curButton.description->setEnabled(!desc.getLocked());
 	}
 
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
@@ -1213,6 +1175,81 @@ void SaveLoadChooserGrid::updateSaves() {
 		_nextButton->setEnabled(false);
 }
 
+void SaveLoadChooserGrid::updateSlotButton(SlotButton &button, uint index, const SaveStateDescriptor &desc) {
+	const uint saveSlot = _saveList[index].getSaveSlot();
+
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		button.button->setGfx(thumbnail);
+	} else {
+		button.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	button.description->setLabel(Common::U32String(Common::String::format("%d. ", saveSlot)) + _saveList[index].getDescription());
+
+	Common::U32String tooltip(_("Name: "));
+	tooltip += _saveList[index].getDescription();
+
+	if (_saveDateSupport) {
+		const Common::U32String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip +=  _("Date: ") + saveDate;
+		}
+
+		const Common::U32String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
+
+	if (_playTimeSupport) {
+		const Common::U32String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += Common::U32String("\n");
+			tooltip += _("Playtime: ") + playTime;
+		}
+	}
+
+	button.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected.
+	// TODO: Maybe we should not display it at all then?
+	// We also disable and description the button if slot is locked
+	const bool isWriteProtected = desc.getWriteProtectedFlag() ||
+		_saveList[index].getWriteProtectedFlag();
+	if ((_saveMode && isWriteProtected) || desc.getLocked()) {
+		button.button->setEnabled(false);
+	} else {
+		button.button->setEnabled(true);
+	}
+	button.description->setEnabled(!desc.getLocked());
+}
+
+void SaveLoadChooserGrid::handleTickle() {
+	if (!_pendingSlots.empty()) {
+		const uint32 start = g_system->getMillis();
+		do {
+			const uint index = _pendingSlots.front();
+			_pendingSlots.remove_at(0);
+
+			const uint curNum = index - _curPage * _entriesPerPage;
+			if (index >= _saveList.size() || curNum >= _buttons.size())
+				continue;
+
+			SaveStateDescriptor desc = _metaEngine->querySaveMetaInfos(_target.c_str(), _saveList[index].getSaveSlot());
+			if (desc.getSaveSlot() >= 0 && !desc.getDescription().empty())
+				_saveList[index] = desc;
+
+			updateSlotButton(_buttons[curNum], index, desc);
+		} while (!_pendingSlots.empty() && g_system->getMillis() - start < kMetaInfoLoadMillis);
+
+		g_gui.scheduleTopDialogRedraw();
+	}
+
+	SaveLoadChooserDialog::handleTickle();
+}
+
 SavenameDialog::SavenameDialog()
 	: Dialog("SavenameDialog") {
 	_title = new StaticTextWidget(this, "SavenameDialog.DescriptionText", Common::String());
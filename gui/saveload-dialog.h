@@ -219,6 +219,7 @@ public:
 protected:
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
 	void handleMouseWheel(int x, int y, int direction) override;
+	void handleTickle() override;
 	void updateSaveList() override;
 private:
 	int runIntern() override;
@@ -256,6 +257,14 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(SlotButton &button, uint index, const SaveStateDescriptor &desc);
+
+	/**
+	 * Indices into _saveList of the shown slots whose meta infos (thumbnail,
+	 * date, play time) still have to be queried. Querying opens the save
+	 * file, so it is done from handleTickle() after the page is drawn.
+	 */
+	Common::Array<uint> _pendingSlots;
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
@@ -473,7 +473,9 @@ void GridWidget::unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurfac
 const Graphics::ManagedSurface *GridWidget::filenameToSurface(const Common::String &name) {
 	if (name.empty())
 		return nullptr;
-	return _loadedSurfaces[name];
+	// Thumbnails still waiting in _pendingThumbnails have no entry yet, and
+	// must not get one here or they would be considered as already loaded.
+	return _loadedSurfaces.getValOrDefault(name, nullptr);
 }
 
 const Graphics::ManagedSurface *GridWidget::languageToSurface(Common::Language languageCode, Graphics::AlphaType &alphaType) {
@@ -697,44 +699,95 @@ void GridWidget::setGroupHeaderFormat(const Common::U32String &prefix, const Com
 }
 
 void GridWidget::reloadThumbnails() {
-	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
-	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
+	// Only the visible entries are queued, anything scrolled past before
+	// it got decoded is dropped from the queue.
+	_pendingThumbnails.clear();
+
+	Common::HashMap<Common::String, bool> visible;
 	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
 		GridItemInfo *entry = *iter;
 		if (entry->thumbPath.empty())
 			continue;
 
-		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			_loadedSurfaces[entry->thumbPath] = nullptr;
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				if (!_loadedSurfaces.contains(path)) {
-					surf = loadSurfaceFromFile(path);
-				} else {
-					const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
-					_loadedSurfaces[entry->thumbPath] = new Graphics::ManagedSurface(*scSurf);
-				}
+		if (!_loadedSurfaces.contains(entry->thumbPath) && !visible.contains(entry->thumbPath)) {
+			PendingThumbnail thumb;
+			thumb.thumbPath = entry->thumbPath;
+			thumb.engineid = entry->engineid;
+			thumb.gameid = entry->gameid;
+			_pendingThumbnails.push_back(thumb);
+		}
+		visible[entry->thumbPath] = true;
+	}
+
+	// Keep the memory used by thumbnails bounded on large libraries
+	if (_loadedSurfaces.size() > kMaxLoadedThumbnails) {
+		for (Common::HashMap<Common::String, const Graphics::ManagedSurface *>::iterator i = _loadedSurfaces.begin(); i != _loadedSurfaces.end(); ++i) {
+			if (!visible.contains(i->_key)) {
+				delete i->_value;
+				_loadedSurfaces.erase(i);
 			}
+		}
+	}
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
+	// Small grids are fully decoded here and show up right away. On larger
+	// ones the items show their title until handleTickle() gets to them.
+	loadPendingThumbnails(kThumbnailLoadMillis);
+}
 
-				if (path != entry->thumbPath) {
-					_loadedSurfaces[path] = new Graphics::ManagedSurface(*scSurf);
-				}
+void GridWidget::loadThumbnail(const PendingThumbnail &thumb) {
+	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
+	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
 
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
-				}
-			}
+	_loadedSurfaces[thumb.thumbPath] = nullptr;
+	Common::String path = Common::String::format("icons/%s-%s.png", thumb.engineid.c_str(), thumb.gameid.c_str());
+	Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
+	if (!surf) {
+		path = Common::String::format("icons/%s.png", thumb.engineid.c_str());
+		if (!_loadedSurfaces.contains(path)) {
+			surf = loadSurfaceFromFile(path);
+		} else {
+			const Graphics::ManagedSurface *scSurf = _loadedSurfaces.getVal(path);
+			if (scSurf)
+				_loadedSurfaces[thumb.thumbPath] = new Graphics::ManagedSurface(*scSurf);
+		}
+	}
+
+	if (surf) {
+		const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
+		_loadedSurfaces[thumb.thumbPath] = scSurf;
+
+		if (path != thumb.thumbPath) {
+			_loadedSurfaces[path] = new Graphics::ManagedSurface(*scSurf);
+		}
+
+		if (surf != scSurf) {
+			surf->free();
+			delete surf;
 		}
 	}
 }
 
+bool GridWidget::loadPendingThumbnails(uint32 maxMillis) {
+	if (_pendingThumbnails.empty())
+		return false;
+
+	const uint32 start = g_system->getMillis();
+	do {
+		const PendingThumbnail thumb = _pendingThumbnails.front();
+		_pendingThumbnails.pop_front();
+
+		if (!_loadedSurfaces.contains(thumb.thumbPath))
+			loadThumbnail(thumb);
+
+		for (uint i = 0; i < _gridItems.size(); ++i) {
+			if (_gridItems[i]->isVisible() && _gridItems[i]->showsThumbnail(thumb.thumbPath))
+				_gridItems[i]->update();
+		}
+	} while (!_pendingThumbnails.empty() && g_system->getMillis() - start < maxMillis);
+
+	return true;
+}
+
 void GridWidget::loadFlagIcons() {
 	const Common::LanguageDescription *l = Common::g_languages;
 	for (; l->code; ++l) {
@@ -922,6 +975,10 @@ void GridWidget::handleMouseWheel(int x, int y, int direction) {
 	_scrollPos = _scrollBar->_currentPos;
 }
 
+void GridWidget::handleTickle() {
+	loadPendingThumbnails(kThumbnailLoadMillis);
+}
+
 void GridWidget::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 	// Work in progress
 	switch (cmd) {
@@ -24,6 +24,7 @@
 
 #include "gui/dialog.h"
 #include "gui/widgets/scrollbar.h"
+#include "common/list.h"
 #include "common/str.h"
 
 #include "image/bmp.h"
@@ -46,6 +47,11 @@ enum {
 	kItemSizeCmd = 'SIZE'
 };
 
+enum {
+	kMaxLoadedThumbnails = 256, ///< Decoded thumbnails above which the non-visible ones are dropped
+	kThumbnailLoadMillis = 15   ///< Time spent decoding queued thumbnails at once
+};
+
 /* GridItemInfo */
 struct GridItemInfo {
 	bool		isHeader, validEntry;
@@ -109,6 +115,15 @@ protected:
 	// Images are mapped by filename -> surface.
 	Common::HashMap<Common::String, const Graphics::ManagedSurface *> _loadedSurfaces;
 
+	// Thumbnails of visible entries which still have to be decoded.
+	// They are loaded a few at a time from handleTickle().
+	struct PendingThumbnail {
+		Common::String thumbPath;
+		Common::String engineid;
+		Common::String gameid;
+	};
+	Common::List<PendingThumbnail> _pendingThumbnails;
+
 	Common::Array<GridItemInfo>			_dataEntryList;
 	Common::Array<GridItemInfo>			_headerEntryList;
 	Common::Array<GridItemInfo *>		_sortedEntryList;
@@ -198,6 +213,8 @@ public:
 	void saveClosedGroups(const Common::U32String &groupName);
 
 	void reloadThumbnails();
+	void loadThumbnail(const PendingThumbnail &thumb);
+	bool loadPendingThumbnails(uint32 maxMillis);
 	void loadFlagIcons();
 	void loadPlatformIcons();
 	void loadExtraIcons();
@@ -219,6 +236,7 @@ public:
 
 	void handleMouseWheel(int x, int y, int direction) override;
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
+	void handleTickle() override;
 	void reflowLayout() override;
 
 	bool wantsFocus() override { return true; }
@@ -248,6 +266,7 @@ public:
 	void update();
 	void updateThumb();
 	void setActiveEntry(GridItemInfo &entry);
+	bool showsThumbnail(const Common::String &path) const { return _activeEntry && _activeEntry->thumbPath == path; }
 
 	void drawWidget() override;
 
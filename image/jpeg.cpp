@@ -30,6 +30,7 @@
 #include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/util.h"
+#include "graphics/blit.h"
 #include "graphics/pixelformat.h"
 
 #ifdef USE_JPEG
@@ -283,52 +284,73 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	jpeg_start_decompress(&cinfo);
 
 	// Allocate buffers for the output data
+	Graphics::PixelFormat outputPixelFormat;
 	switch (_colorSpace) {
-	case kColorSpaceRGB: {
-		Graphics::PixelFormat outputPixelFormat;
+	case kColorSpaceRGB:
 		if (cinfo.out_color_space == JCS_RGB) {
 			outputPixelFormat = getByteOrderRgbPixelFormat();
 		} else {
 			outputPixelFormat = _requestedPixelFormat;
 		}
-		_surface.create(cinfo.output_width, cinfo.output_height, outputPixelFormat);
 		break;
-	}
 	case kColorSpaceYUV:
 		// We use YUV with 3 bytes per pixel otherwise.
 		// This is pretty ugly since our PixelFormat cannot express YUV...
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
+		outputPixelFormat = Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0);
 		break;
 	default:
 		break;
 	}
 	// Size of output pixel must match 4 bytes.
 	if (cinfo.out_color_space == JCS_CMYK) {
-		assert(_surface.format.bytesPerPixel == 4);
+		assert(outputPixelFormat.bytesPerPixel == 4);
 	}
 
-	// Allocate buffer for one scanline
-	JDIMENSION pitch = cinfo.output_width * _surface.format.bytesPerPixel;
-	assert(_surface.pitch >= (int)pitch);
-	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	// When libjpeg cannot output the requested pixel format itself, the
+	// decoded scanlines are converted as they come instead of converting
+	// the whole surface in place afterwards.
+	const bool convert = _colorSpace == kColorSpaceRGB && outputPixelFormat != _requestedPixelFormat;
+
+	_surface.create(cinfo.output_width, cinfo.output_height, convert ? _requestedPixelFormat : outputPixelFormat);
+
+	// libjpeg outputs up to rec_outbuf_height scanlines per call
+	JDIMENSION pitch = cinfo.output_width * outputPixelFormat.bytesPerPixel;
+	int rowCount = MAX(cinfo.rec_outbuf_height, 1);
+	JSAMPARRAY rows;
+	if (convert) {
+		rows = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, rowCount);
+	} else {
+		assert(_surface.pitch >= (int)pitch);
+		rows = (JSAMPARRAY)(*cinfo.mem->alloc_small)((j_common_ptr)&cinfo, JPOOL_IMAGE, rowCount * sizeof(JSAMPROW));
+	}
 
-	// Go through the image data scanline by scanline
+	// Go through the image data, decoding straight into the surface when possible
 	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
+		JDIMENSION y = cinfo.output_scanline;
+		JDIMENSION maxLines = MIN<JDIMENSION>(rowCount, cinfo.output_height - y);
+
+		if (!convert) {
+			for (JDIMENSION i = 0; i < maxLines; i++)
+				rows[i] = (JSAMPROW)_surface.getBasePtr(0, y + i);
+		}
 
-		jpeg_read_scanlines(&cinfo, buffer, 1);
+		JDIMENSION lines = jpeg_read_scanlines(&cinfo, rows, maxLines);
+		if (lines == 0)
+			break;
 
-		memcpy(dst, buffer[0], pitch);
+		if (convert) {
+			for (JDIMENSION i = 0; i < lines; i++) {
+				if (!Graphics::crossBlit((byte *)_surface.getBasePtr(0, y + i), rows[i], _surface.pitch, pitch,
+				                         _surface.w, 1, _surface.format, outputPixelFormat))
+					error("JPEGDecoder: Unable to convert to pixel format %s", _requestedPixelFormat.toString().c_str());
+			}
+		}
 	}
 
 	// We are done with decompressing, thus free all the data
 	jpeg_finish_decompress(&cinfo);
 	jpeg_destroy_decompress(&cinfo);
 
-	if (_colorSpace == kColorSpaceRGB && _surface.format != _requestedPixelFormat) {
-		_surface.convertToInPlace(_requestedPixelFormat); // Slow path
-	}
-
 	return true;
 #else
 	return false;
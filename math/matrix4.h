@@ -108,6 +108,28 @@ public:
 		return result;
 	}
 
+	/**
+	 * Transforms the vector src and adds the result, scaled by weight, to dst.
+	 * This is the inner step of CPU vertex skinning, and avoids the temporary
+	 * vectors of transform().
+	 *
+	 * @param dst		The 3 component vector to add the result to.
+	 * @param src		The 3 component vector to transform.
+	 * @param weight	The factor to scale the transformed vector by.
+	 * @param translate	Whether to apply the translation part of the matrix.
+	 */
+	inline void transformAdd(float *dst, const float *src, float weight, bool translate) const {
+		const float *m = getData();
+		const float w = translate ? 1.f : 0.f;
+
+		for (int i = 0; i < 3; i++) {
+			dst[i] += weight * (m[i * 4 + 0] * src[0] +
+			                    m[i * 4 + 1] * src[1] +
+			                    m[i * 4 + 2] * src[2] +
+			                    m[i * 4 + 3] * w);
+		}
+	}
+
 	inline bool inverse() {
 		Matrix<4, 4> invMatrix;
 		float *inv = invMatrix.getData();
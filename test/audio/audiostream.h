@@ -4,6 +4,8 @@
 
 #include "helper.h"
 
+#include "../null_osystem.h"
+
 class AudioStreamTestSuite : public CxxTest::TestSuite
 {
 public:
@@ -205,4 +207,38 @@ public:
 	void test_sub_looping_audio_stream_stereo_22050_end_fixed_iter() {
 		testSubLoopingAudioStreamFixedIter(22050, true, 2, 2);
 	}
+
+	void test_looping_prefetching_audio_stream() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const int sampleRate = 11025;
+		const int loops = 3;
+
+		int16 *sine = 0;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(sampleRate, 1, &sine, false, false);
+		// The test timer manager never decodes ahead, so every iteration
+		// plays what rewinding decoded. The buffer holds all of it.
+		Audio::PrefetchingAudioStream *prefetch = Audio::makePrefetchingAudioStream(s, 1500);
+		Audio::LoopingAudioStream *loop = new Audio::LoopingAudioStream(prefetch, loops);
+
+		// Read in chunks which do not line up with the loop ends, like the mixer
+		int16 *buffer = new int16[sampleRate * loops];
+		for (int pos = 0; pos < sampleRate * loops; pos += 1000) {
+			const int count = MIN(1000, sampleRate * loops - pos);
+			TS_ASSERT_EQUALS(loop->readBuffer(buffer + pos, count), count);
+		}
+
+		// No silence is inserted when rewinding
+		for (int i = 0; i < loops; ++i)
+			TS_ASSERT_EQUALS(memcmp(buffer + i * sampleRate, sine, sampleRate * sizeof(int16)), 0);
+		TS_ASSERT_EQUALS(prefetch->getUnderruns(), (uint32)0);
+		TS_ASSERT_EQUALS(loop->getCompleteIterations(), (uint)loops);
+		TS_ASSERT(loop->endOfData());
+
+		delete[] buffer;
+		delete loop;
+		delete[] sine;
+#endif
+	}
 };
@@ -0,0 +1,222 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/midiparser_smf.h"
+#include "common/array.h"
+
+/**
+ * The channel, SysEx and META state the events fired by a parser result in.
+ */
+struct FiredState {
+	byte notes[16][128];
+	int16 controllers[16][128];
+	int16 programs[16];
+	int16 pitchBends[16];
+	uint32 tempo;
+	Common::Array<const byte *> sysExAndMeta;
+
+	FiredState() { reset(); }
+
+	void reset() {
+		memset(notes, 0, sizeof(notes));
+		memset(controllers, 0xFF, sizeof(controllers));
+		memset(programs, 0xFF, sizeof(programs));
+		memset(pitchBends, 0xFF, sizeof(pitchBends));
+		tempo = 0;
+		sysExAndMeta.clear();
+	}
+
+	void fire(const EventInfo &info) {
+		const byte channel = info.channel();
+		switch (info.command()) {
+		case 0x8:
+			notes[channel][info.basic.param1] = 0;
+			break;
+		case 0x9:
+			notes[channel][info.basic.param1] = info.basic.param2;
+			break;
+		case 0xB:
+			controllers[channel][info.basic.param1] = info.basic.param2;
+			break;
+		case 0xC:
+			programs[channel] = info.basic.param1;
+			break;
+		case 0xE:
+			pitchBends[channel] = info.basic.param1 | (info.basic.param2 << 7);
+			break;
+		default:
+			if (info.event == 0xFF && info.ext.type == 0x51)
+				tempo = READ_BE_UINT24(info.ext.data);
+			else if (info.event == 0xF0 || info.event == 0xFF)
+				sysExAndMeta.push_back(info.ext.data);
+			break;
+		}
+	}
+
+	bool operator==(const FiredState &other) const {
+		return !memcmp(notes, other.notes, sizeof(notes)) &&
+			!memcmp(controllers, other.controllers, sizeof(controllers)) &&
+			!memcmp(programs, other.programs, sizeof(programs)) &&
+			!memcmp(pitchBends, other.pitchBends, sizeof(pitchBends)) &&
+			tempo == other.tempo && sysExAndMeta == other.sysExAndMeta;
+	}
+};
+
+class JumpTestParser : public MidiParser_SMF {
+public:
+	JumpTestParser(bool snapshots) : _snapshots(snapshots) {}
+
+	FiredState fired;
+
+	uint32 lastEventTick() const { return _position._lastEventTick; }
+	uint32 lastEventTime() const { return _position._lastEventTime; }
+	uint32 playTime() const { return _position._playTime; }
+	const byte *playPos() const { return _position._playPos; }
+	uint32 psecPerTick() const { return _psecPerTick; }
+	uint numSnapshots() const { return _jumpSnapshots.size(); }
+
+protected:
+	bool supportsJumpSnapshots() const override { return _snapshots; }
+
+	bool processEvent(const EventInfo &info, bool fireEvents) override {
+		// There is no driver to send the events to
+		if (fireEvents)
+			fired.fire(info);
+		return MidiParser_SMF::processEvent(info, false);
+	}
+
+private:
+	bool _snapshots;
+};
+
+class MidiParserTestSuite : public CxxTest::TestSuite
+{
+private:
+	static void append(Common::Array<byte> &data, const byte *bytes, uint size) {
+		for (uint i = 0; i < size; ++i)
+			data.push_back(bytes[i]);
+	}
+
+	/**
+	 * Creates a type 0 SMF with numEvents note on events, 10 ticks apart,
+	 * and tempo changes starting after the first 50 events. Note offs,
+	 * controller, program and pitch bend changes and SysEx events are
+	 * mixed in without delay.
+	 */
+	static void createSMF(Common::Array<byte> &data, uint numEvents) {
+		static const byte header[] = { 'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96, 'M', 'T', 'r', 'k', 0, 0, 0, 0 };
+		data.resize(sizeof(header));
+		memcpy(&data[0], header, sizeof(header));
+
+		for (uint i = 0; i < numEvents; ++i) {
+			if (i % 300 == 50) {
+				uint32 tempo = 400000 + (i / 300) * 25000;
+				const byte tempoEvent[] = { 10, 0xFF, 0x51, 3, (byte)(tempo >> 16), (byte)(tempo >> 8), (byte)tempo };
+				for (uint j = 0; j < sizeof(tempoEvent); ++j)
+					data.push_back(tempoEvent[j]);
+			}
+			data.push_back(10);
+			data.push_back(0x90 | (i % 4));
+			data.push_back(i % 128);
+			data.push_back(0x40 + i % 32);
+
+			// Turn off most notes again some events later
+			if (i >= 5 && i % 3) {
+				const byte noteOff[] = { 0, (byte)(0x80 | ((i - 5) % 4)), (byte)((i - 5) % 128), 0 };
+				append(data, noteOff, sizeof(noteOff));
+			}
+			if (i % 7 == 0) {
+				static const byte controllers[] = { 7, 10, 64, 0, 101, 100, 6 };
+				const byte controller[] = { 0, (byte)(0xB0 | (i % 5)), controllers[i / 7 % ARRAYSIZE(controllers)], (byte)(i % 128) };
+				append(data, controller, sizeof(controller));
+			}
+			if (i % 53 == 0) {
+				const byte program[] = { 0, (byte)(0xC0 | (i % 3)), (byte)(i % 128) };
+				append(data, program, sizeof(program));
+			}
+			if (i % 31 == 0) {
+				const byte pitchBend[] = { 0, (byte)(0xE0 | (i % 2)), (byte)(i % 128), (byte)(i / 128 % 128) };
+				append(data, pitchBend, sizeof(pitchBend));
+			}
+			if (i % 211 == 0) {
+				const byte sysEx[] = { 0, 0xF0, 4, 0x7D, (byte)(i % 128), (byte)(i / 128 % 128), 0xF7 };
+				append(data, sysEx, sizeof(sysEx));
+			}
+			if (i % 499 == 0) {
+				// All notes off
+				const byte allNotesOff[] = { 0, (byte)(0xB0 | (i % 4)), 123, 0 };
+				append(data, allNotesOff, sizeof(allNotesOff));
+			}
+		}
+
+		data.push_back(0);
+		data.push_back(0xFF);
+		data.push_back(0x2F);
+		data.push_back(0);
+
+		uint32 trackLength = data.size() - sizeof(header);
+		WRITE_BE_UINT32(&data[sizeof(header) - 4], trackLength);
+	}
+
+public:
+	void test_jump_snapshots() {
+		Common::Array<byte> data;
+		createSMF(data, 2000);
+
+		JumpTestParser reference(false);
+		JumpTestParser parser(true);
+		TS_ASSERT(reference.loadMusic(&data[0], data.size()));
+		TS_ASSERT(parser.loadMusic(&data[0], data.size()));
+
+		static const uint32 ticks[] = { 15000, 3000, 19995, 100, 25000, 7, 12345, 400, 0, 17777 };
+		for (uint i = 0; i < ARRAYSIZE(ticks); ++i) {
+			// The scan starts with the current tempo, which must not
+			// affect the result of jumps resuming from a snapshot
+			uint32 tempo = 300000 + i * 50000;
+			reference.setTempo(tempo);
+			parser.setTempo(tempo);
+
+			TS_ASSERT_EQUALS(reference.jumpToTick(ticks[i]), parser.jumpToTick(ticks[i]));
+			TS_ASSERT_EQUALS(reference.getTick(), parser.getTick());
+			TS_ASSERT_EQUALS(reference.lastEventTick(), parser.lastEventTick());
+			TS_ASSERT_EQUALS(reference.lastEventTime(), parser.lastEventTime());
+			TS_ASSERT_EQUALS(reference.playTime(), parser.playTime());
+			TS_ASSERT_EQUALS(reference.playPos(), parser.playPos());
+			TS_ASSERT_EQUALS(reference.psecPerTick(), parser.psecPerTick());
+		}
+
+		TS_ASSERT_EQUALS(reference.numSnapshots(), 0U);
+		TS_ASSERT(parser.numSnapshots() > 0);
+
+		parser.unloadMusic();
+		TS_ASSERT_EQUALS(parser.numSnapshots(), 0U);
+	}
+
+	void test_jump_snapshots_fire_events() {
+		Common::Array<byte> data;
+		createSMF(data, 2000);
+
+		JumpTestParser reference(false);
+		JumpTestParser parser(true);
+		TS_ASSERT(reference.loadMusic(&data[0], data.size()));
+		TS_ASSERT(parser.loadMusic(&data[0], data.size()));
+
+		static const uint32 ticks[] = { 15000, 3000, 19995, 100, 25000, 7, 12345, 400, 17777, 8000 };
+		for (uint i = 0; i < ARRAYSIZE(ticks); ++i) {
+			// A jump from a snapshot must fire the state a scan from the
+			// start results in, with or without sending note ons
+			const bool dontSendNoteOn = (i % 3 == 2);
+			reference.fired.reset();
+			parser.fired.reset();
+
+			TS_ASSERT_EQUALS(reference.jumpToTick(ticks[i], true, true, dontSendNoteOn), parser.jumpToTick(ticks[i], true, true, dontSendNoteOn));
+			TS_ASSERT_EQUALS(reference.getTick(), parser.getTick());
+			TS_ASSERT_EQUALS(reference.playTime(), parser.playTime());
+			TS_ASSERT_EQUALS(reference.playPos(), parser.playPos());
+			TS_ASSERT_EQUALS(reference.psecPerTick(), parser.psecPerTick());
+			TS_ASSERT(reference.fired == parser.fired);
+		}
+
+		TS_ASSERT(!parser.fired.sysExAndMeta.empty());
+		TS_ASSERT(parser.numSnapshots() > 0);
+	}
+};
@@ -0,0 +1,74 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mods/paula.h"
+
+#include "../null_osystem.h"
+
+class TestPaula : public Audio::Paula {
+public:
+	TestPaula(bool stereo, FilterMode filterMode) : Paula(stereo, 44100, 500, filterMode), _ticks(0) {
+		for (uint i = 0; i < sizeof(_sample); ++i)
+			_sample[i] = (int8)((i * 37) ^ (i >> 3));
+
+		setAudioFilter(true);
+		startPlay();
+	}
+
+private:
+	void interrupt() override {
+		if (++_ticks > 40) {
+			stopPlay();
+			return;
+		}
+
+		// Restart and retune the voices every few ticks, at different offsets
+		for (byte voice = 0; voice < NUM_VOICES; ++voice) {
+			if ((_ticks + voice) % 5 == 1)
+				setChannelData(voice, _sample + voice * 64, _sample + 512, 600 + voice * 40, 256, voice * 3);
+			setChannelPeriod(voice, 120 + ((_ticks * 31 + voice * 77) % 400));
+			setChannelVolume(voice, (_ticks * 13 + voice * 20) % 65);
+		}
+
+		setAudioFilter(_ticks % 7 != 0);
+	}
+
+	int8 _sample[1024];
+	uint _ticks;
+};
+
+class PaulaTestSuite : public CxxTest::TestSuite
+{
+private:
+	static void checkRenderBuffer(bool stereo, Audio::Paula::FilterMode filterMode) {
+		const int numSamples = 50000;
+		int16 *read = new int16[numSamples];
+		int16 *rendered = new int16[numSamples];
+
+		TestPaula reference(stereo, filterMode);
+		for (int i = 0; i < numSamples; i += 1000)
+			TS_ASSERT_EQUALS(reference.readBuffer(read + i, 1000), 1000);
+
+		TestPaula paula(stereo, filterMode);
+		const int count = paula.renderBuffer(rendered, numSamples);
+
+		// The player stops after 40 interrupts of 500 samples each
+		TS_ASSERT_EQUALS(count, 40 * 500 * (stereo ? 2 : 1));
+		TS_ASSERT(!paula.playing());
+		TS_ASSERT_SAME_DATA(read, rendered, count * sizeof(int16));
+
+		delete[] read;
+		delete[] rendered;
+	}
+
+public:
+	void test_render_buffer() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		checkRenderBuffer(false, Audio::Paula::kFilterModeNone);
+		checkRenderBuffer(false, Audio::Paula::kFilterModeA500);
+		checkRenderBuffer(true, Audio::Paula::kFilterModeA1200);
+		checkRenderBuffer(true, Audio::Paula::kFilterModeNone);
+#endif
+	}
+};
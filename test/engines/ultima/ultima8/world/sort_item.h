@@ -869,4 +869,34 @@ class U8SortItemTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT(!si1.overlap(si2));
 		TS_ASSERT(!si2.overlap(si1));
 	}
+
+	/* List order is by z, then flats first, then the order items were added */
+	void test_list_before() {
+		Ultima::Ultima8::SortItem si1;
+		Ultima::Ultima8::SortItem si2;
+
+		Ultima::Ultima8::Box b1(0, 0, 0, 128, 128, 32);
+		Ultima::Ultima8::Box b2(256, 256, 8, 128, 128, 32);
+		si1.setBoxBounds(b1, 0, 0);
+		si2.setBoxBounds(b2, 0, 0);
+		si1._seq = 1;
+		si2._seq = 0;
+
+		TS_ASSERT(si1.listBefore(si2));
+		TS_ASSERT(!si2.listBefore(si1));
+
+		// Equal z, so falls back to order added
+		b2 = Ultima::Ultima8::Box(256, 256, 0, 128, 128, 32);
+		si2.setBoxBounds(b2, 0, 0);
+
+		TS_ASSERT(!si1.listBefore(si2));
+		TS_ASSERT(si2.listBefore(si1));
+
+		// Flats come before non-flats at equal z
+		b1 = Ultima::Ultima8::Box(0, 0, 0, 128, 128, 0);
+		si1.setBoxBounds(b1, 0, 0);
+
+		TS_ASSERT(si1.listBefore(si2));
+		TS_ASSERT(!si2.listBefore(si1));
+	}
 };
@@ -0,0 +1,114 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/jpeg.h"
+#include "graphics/surface.h"
+
+class JPEGDecoderTestSuite : public CxxTest::TestSuite {
+#ifdef USE_JPEG
+	// 16x8 image with a red and green gradient
+	static const uint8 *getJpegData(uint32 &size) {
+		static const uint8 jpegBuf[324] = {
+			0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01,
+			0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43,
+			0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x04,
+			0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0a, 0x07,
+			0x07, 0x06, 0x08, 0x0c, 0x0a, 0x0c, 0x0c, 0x0b, 0x0a, 0x0b, 0x0b, 0x0d,
+			0x0e, 0x12, 0x10, 0x0d, 0x0e, 0x11, 0x0e, 0x0b, 0x0b, 0x10, 0x16, 0x10,
+			0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0c, 0x0f, 0x17, 0x18, 0x16, 0x14,
+			0x18, 0x12, 0x14, 0x15, 0x14, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x03, 0x04,
+			0x04, 0x05, 0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0d, 0x0b, 0x0d,
+			0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+			0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+			0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+			0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+			0x14, 0x14, 0xff, 0xc0, 0x00, 0x11, 0x08, 0x00, 0x08, 0x00, 0x10, 0x03,
+			0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xff, 0xc4, 0x00,
+			0x15, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xff, 0xc4, 0x00, 0x19,
+			0x10, 0x00, 0x01, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x08, 0x24, 0x32, 0xa2, 0xff,
+			0xc4, 0x00, 0x15, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x06, 0xff, 0xc4,
+			0x00, 0x1d, 0x11, 0x00, 0x01, 0x03, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x06, 0x23, 0x07,
+			0x21, 0x22, 0x31, 0x51, 0xf0, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00,
+			0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00, 0x96, 0xa4, 0xda, 0xa5, 0x21,
+			0xe4, 0xb3, 0x24, 0xda, 0xa5, 0x21, 0xe4, 0x00, 0x63, 0x2e, 0x72, 0x77,
+			0x91, 0x48, 0xd3, 0x67, 0x89, 0x8c, 0x25, 0xe7, 0xb6, 0xbf, 0xff, 0xd9,
+		};
+
+		size = sizeof(jpegBuf);
+		return jpegBuf;
+	}
+
+	// Decode the test image in the requested format and compare
+	// it to the byte order RGB output of the decoder
+	void checkOutputFormat(const Graphics::PixelFormat &format) {
+		uint32 size;
+		const uint8 *data = getJpegData(size);
+
+		Image::JPEGDecoder rgbDecoder;
+		Common::MemoryReadStream rgbStream(data, size);
+		TS_ASSERT(rgbDecoder.loadStream(rgbStream));
+		const Graphics::Surface *rgb = rgbDecoder.getSurface();
+
+		Image::JPEGDecoder decoder;
+		decoder.setOutputPixelFormat(format);
+		Common::MemoryReadStream stream(data, size);
+		TS_ASSERT(decoder.loadStream(stream));
+		const Graphics::Surface *surface = decoder.getSurface();
+
+		TS_ASSERT_EQUALS(surface->w, 16);
+		TS_ASSERT_EQUALS(surface->h, 8);
+		TS_ASSERT_EQUALS(surface->format, format);
+
+		for (int y = 0; y < surface->h; y++) {
+			for (int x = 0; x < surface->w; x++) {
+				uint8 r, g, b;
+				rgb->format.colorToRGB(rgb->getPixel(x, y), r, g, b);
+				TS_ASSERT_EQUALS(surface->getPixel(x, y), format.RGBToColor(r, g, b));
+			}
+		}
+	}
+#endif
+
+public:
+	void test_load_jpeg_rgb() {
+#ifdef USE_JPEG
+		uint32 size;
+		const uint8 *data = getJpegData(size);
+
+		Image::JPEGDecoder decoder;
+		Common::MemoryReadStream stream(data, size);
+		TS_ASSERT(decoder.loadStream(stream));
+
+		const Graphics::Surface *surface = decoder.getSurface();
+		TS_ASSERT_EQUALS(surface->w, 16);
+		TS_ASSERT_EQUALS(surface->h, 8);
+		TS_ASSERT_EQUALS(surface->format.bytesPerPixel, 3);
+
+		// Lossy, but the gradient must be roughly preserved
+		uint8 r, g, b;
+		surface->format.colorToRGB(surface->getPixel(15, 7), r, g, b);
+		TS_ASSERT_LESS_THAN(200, r);
+		TS_ASSERT_LESS_THAN(180, g);
+#endif
+	}
+
+	void test_load_jpeg_rgba() {
+#ifdef USE_JPEG
+		checkOutputFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+#endif
+	}
+
+	void test_load_jpeg_rgb565() {
+#ifdef USE_JPEG
+		checkOutputFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+#endif
+	}
+};
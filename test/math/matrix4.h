@@ -0,0 +1,31 @@
+#include <cxxtest/TestSuite.h>
+
+#include "math/matrix4.h"
+
+class Matrix4TestSuite : public CxxTest::TestSuite {
+public:
+	void test_transformAdd() {
+		Math::Matrix4 m;
+		m.buildAroundY(Math::Angle(30));
+		m.setPosition(Math::Vector3d(1, -2, 3));
+
+		const float src[3] = { 4, 5, 6 };
+		float dst[3] = { 1, 1, 1 };
+
+		Math::Vector3d expected(src[0], src[1], src[2]);
+		m.transform(&expected, true);
+		m.transformAdd(dst, src, 0.5f, true);
+		TS_ASSERT_DELTA(dst[0], 1 + 0.5f * expected.x(), 0.0001f);
+		TS_ASSERT_DELTA(dst[1], 1 + 0.5f * expected.y(), 0.0001f);
+		TS_ASSERT_DELTA(dst[2], 1 + 0.5f * expected.z(), 0.0001f);
+
+		// Without translation only the rotation is applied
+		expected.set(src[0], src[1], src[2]);
+		m.transform(&expected, false);
+		dst[0] = dst[1] = dst[2] = 0;
+		m.transformAdd(dst, src, 1.0f, false);
+		TS_ASSERT_DELTA(dst[0], expected.x(), 0.0001f);
+		TS_ASSERT_DELTA(dst[1], expected.y(), 0.0001f);
+		TS_ASSERT_DELTA(dst[2], expected.z(), 0.0001f);
+	}
+};
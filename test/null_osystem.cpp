@@ -4,6 +4,45 @@
 #define NULL_DRIVER_USE_FOR_TEST 1
 #include "null_osystem.h"
 #include "../backends/platform/null/null.cpp"
+#include "backends/mixer/mixer.h"
+#include "common/timer.h"
+
+/**
+ * A mixer which is never called back, for testing code which requires
+ * one, like Paula.
+ */
+class TestMixerManager : public MixerManager {
+public:
+	void init() override {
+		_mixer = new Audio::MixerImpl(44100);
+		_mixer->setReady(true);
+	}
+
+	void suspendAudio() override { _audioSuspended = true; }
+	int resumeAudio() override { _audioSuspended = false; return 0; }
+};
+
+/**
+ * A timer manager which never calls the installed procs, so that tests
+ * of code doing work from timers stay deterministic.
+ */
+class TestTimerManager : public Common::TimerManager {
+public:
+	bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id) override { return true; }
+	void removeTimerProc(TimerProc proc) override {}
+};
+
+class OSystem_NULL_Test : public OSystem_NULL {
+public:
+	OSystem_NULL_Test(bool silenceLogs) : OSystem_NULL(silenceLogs) {}
+
+	// The mixer needs g_system to be set up
+	void initManagers() {
+		_timerManager = new TestTimerManager();
+		_mixerManager = new TestMixerManager();
+		_mixerManager->init();
+	}
+};
 
 //#define DISPLAY_ERROR_MESSAGES
 
@@ -14,7 +53,9 @@ void Common::install_null_g_system() {
 	const bool silenceLogs = true;
 #endif
 
-	g_system = OSystem_NULL_create(silenceLogs);
+	OSystem_NULL_Test *system = new OSystem_NULL_Test(silenceLogs);
+	g_system = system;
+	system->initManagers();
 }
 
 void OSystem_NULL::quit() {